@@ -1,14 +1,255 @@
 #ifndef ALFABETA_H
 #define ALFABETA_H
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 #include "Board.h"
+#include "MovePicker.h"
+#include "ThreadPool.h"
+#include "TimeManager.h"
+#include "TranspositionTable.h"
 
 class Board;
 
+// Move of the searched position with its score from the last completed iteration
+struct RootMove {
+    Move move;
+    int score; // Exact if within the margin of the best score, otherwise only a bound
+};
+
+// Outcome of an iterative deepening search
+struct SearchResult {
+    std::vector<RootMove> root_moves; // Best move first (highest score for white, lowest for black)
+    std::vector<Move> principal_variation; // Expected line of play, starting with the best move
+    int depth = 0; // Depth of the last completed iteration
+    std::uint64_t nodes = 0; // Positions visited by all iterations
+};
+
 class AlfaBetaPruning {
 public:
+    // Margin of the delta pruning: captures that cannot lift the score to alpha even with this
+    // positional gain on top of the captured material are skipped by the quiescence search
+    static constexpr int DELTA_MARGIN = 4 * Board::material_rating_weight;
+
+    // Half width of the first aspiration window around the score of the previous iteration
+    static constexpr int ASPIRATION_WINDOW = Board::material_rating_weight / 2;
+
+    // Pruning near the leaves by the static rating, margins grow by the given amount per remaining ply:
+    // futility pruning skips quiet moves, reverse futility pruning returns the rating beyond the
+    // window and razoring drops into the quiescence search
+    static constexpr int FUTILITY_MAX_DEPTH = 2;
+    static constexpr int FUTILITY_MARGIN = 2 * Board::material_rating_weight;
+    static constexpr int REVERSE_FUTILITY_MAX_DEPTH = 3;
+    static constexpr int REVERSE_FUTILITY_MARGIN = 2 * Board::material_rating_weight;
+    static constexpr int RAZOR_MAX_DEPTH = 2;
+    static constexpr int RAZOR_MARGIN = 4 * Board::material_rating_weight;
+
+    // Captures losing more than SEE_PRUNING_MARGIN (in Piece::get_value units) per remaining ply
+    // by static exchange evaluation are pruned up to this remaining depth
+    static constexpr int SEE_PRUNING_MAX_DEPTH = 3;
+    static constexpr int SEE_PRUNING_MARGIN = 1;
+
+    // Null move pruning is tried from this remaining depth on, the null move is searched
+    // NULL_MOVE_REDUCTION plies shallower (one more in deep searches)
+    static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    static constexpr int NULL_MOVE_REDUCTION = 2;
+
+    // Late move reductions apply from this remaining depth on, to the quiet moves after the first LMR_MIN_MOVES
+    static constexpr int LMR_MIN_DEPTH = 3;
+    static constexpr int LMR_MIN_MOVES = 3;
+
+    // Plies the search of a late quiet move is reduced by (from a precomputed table)
+    static int late_move_reduction(int depth, int move_count);
+
+    // Nodes of a parallel search split from this remaining depth on
+    static constexpr int SPLIT_MIN_DEPTH = 4;
+
+    // History scores are halved once one of them reaches this value
+    static constexpr int HISTORY_LIMIT = 1 << 20;
+
+    // Transposition table shared by every search of this instance (size in megabytes)
+    explicit AlfaBetaPruning(std::size_t table_megabytes = 16);
+
     // Evaluates the best move for the given board state using the Alpha-Beta pruning algorithm.
+    // The board is copied once, the search itself makes and takes back moves in place.
+    // With several threads the search splits (Young Brothers Wait): once the first move of a
+    // node is searched, its other moves become tasks that idle threads steal
     int operator()(Board board, int depth, int alpha, int beta);
+
+    // Searches the legal moves of the board at depth 1, 2, ... until a limit is reached, every
+    // iteration starting with the best moves of the previous one. An iteration aborted at the
+    // hard deadline is dropped, if it was the first one only the first legal move is returned
+    // (depth 0). Root moves scoring within margin of the best move get exact scores, so that the
+    // caller can choose among them.
+    SearchResult iterative_deepening(Board board, const SearchLimits& limits, int margin = 0);
+
+    // Mark the start of a new search (e.g. a new move of the game) for the table replacement
+    void new_search();
+
+    // Change the size of the transposition table (clears it)
+    void set_table_size(std::size_t megabytes);
+
+    // Number of threads of the searches, kept in a pool between searches. In iterative_deepening
+    // the helper threads search the root on their own at staggered depths from the start to the
+    // end of the search and share their results through the transposition table (Lazy SMP). They
+    // leave their own searches when the root moves after the first are shared out among all
+    // threads. The plain search splits its nodes instead (see operator()). One thread (the
+    // default) searches alone
+    void set_threads(int count);
+    int thread_count() const {return int(threads.size());}
+
+    // Let the nodes of iterative_deepening split like those of the plain search, the helper
+    // threads then take their tasks instead of searching on their own (off by default)
+    void set_young_brothers_wait(bool enabled) {young_brothers_wait = enabled;}
+
+    // Tasks of split points taken by a thread other than their owner during the last search
+    std::uint64_t stolen_tasks() const;
+
+private:
+    struct SplitPoint;
+
+    // Move of a split point searched by whichever thread takes it
+    struct Task {
+        SplitPoint* split;
+        Move move;
+        int move_count; // Position of the move in the order of the node
+    };
+
+    // Search state of one thread, everything else is shared by the threads
+    struct SearchThread {
+        std::uint64_t nodes = 0; // Positions visited by the current search
+        std::uint64_t stolen = 0; // Tasks of other threads taken by the current search
+        bool lazy = false; // Searching the root on its own (Lazy SMP), which gives way to the root moves
+        int root_job_number = 0; // Last root moves job the thread joined
+        std::atomic<bool> cancelled = false; // The work of the thread is no longer needed, it is unwinding
+        const SplitPoint* split = nullptr; // Split point of the task the thread is working on
+
+        // Tasks of the split points of this thread, the owner works at the back and thieves steal from the front
+        std::deque<Task> tasks;
+        std::mutex tasks_mutex;
+
+        // Move ordering statistics, collected from the cutoffs of the current search
+        std::array<KillerMoves, MAX_SEARCH_DEPTH + 1> killers; // Indexed by the distance to the root
+        HistoryTable history;
+    };
+
+    // Node whose moves after the first are searched in parallel, kept on the stack of its owner
+    // until every task is done
+    struct SplitPoint {
+        const SplitPoint* parent; // Split point of the task the owner was working on
+        Board board; // Position of the node
+        int depth;
+        int ply;
+        bool in_check;
+        bool pv_node;
+
+        // Window and result, narrowed by every finished task
+        std::mutex mutex; // Held while updating them
+        std::atomic<int> alpha;
+        std::atomic<int> beta;
+        int best_score;
+        Move best_move;
+
+        std::atomic<bool> cutoff = false; // A move failed high, the others are not needed
+        std::atomic<int> pending = 0; // Tasks not finished yet
+
+        // A cutoff here or at any split point above makes the work of the tasks useless
+        bool cancelled() const {
+            for (const SplitPoint* split = this; split; split = split->parent) {
+                if (split->cutoff) return true;
+            }
+            return false;
+        }
+    };
+
+    TranspositionTable transposition_table;
+    TimeManager time_manager;
+
+    std::vector<SearchThread> threads; // The first one belongs to the caller of the search
+    std::unique_ptr<ThreadPool> pool; // Runs the other threads
+    bool can_stop = false; // The search is aborted at the hard deadline, only iterative_deepening has one
+    std::atomic<bool> stopped = false; // The hard deadline passed, the threads are unwinding
+
+    bool young_brothers_wait = false; // iterative_deepening splits its nodes as well
+    bool splitting = false; // A parallel search is running, its nodes split
+    std::atomic<bool> search_done = false; // The parallel search returned, the helper threads stop
+    std::atomic<int> root_depth = 0; // Iteration of the main thread in iterative_deepening
+
+    // Search of the root moves after the first one, joined by the helper threads
+    using RootMovesJob = std::function<void(SearchThread&)>;
+    std::mutex root_mutex; // Held while the job is opened, joined or closed
+    std::atomic<const RootMovesJob*> root_job = nullptr; // Open job, if any
+    int root_job_number = 0; // Counts the jobs, so that a helper joins each of them once
+    std::atomic<int> root_workers = 0; // Helpers working on the job
+
+    // The search of the thread has to return, its result is not used
+    bool aborted(const SearchThread& thread) const {
+        return stopped || thread.cancelled || (thread.split && thread.split->cancelled()) ||
+               (thread.lazy && (root_job || search_done));
+    }
+
+    // Loop of a helper thread of iterative_deepening on the root, until the search is done
+    void helper_search(SearchThread& thread, Board board, int max_depth, int index);
+
+    // Take part in the open root moves job, unless the thread already did. False if it did not
+    bool join_root_moves(SearchThread& thread);
+
+    // Recursive search on a board that is restored before returning, ply is the distance to the root.
+    // null_move is false right after a null move, so that two of them never follow each other
+    int search(SearchThread& thread, Board& board, int depth, int alpha, int beta, int ply = 0, bool null_move = true);
+
+    // Search of a move after the first one of a node, the board is after the move
+    int search_later_move(SearchThread& thread, Board& board, int depth, int alpha, int beta, int ply, int reduction);
+
+    // Plies a move after the first one is reduced by, 0 for the moves searched to full depth
+    static int late_move_reduction(int depth, int move_count, bool quiet, bool in_check, bool gives_check, bool pv_node);
+
+    // Hand the remaining moves of the picker out as tasks and wait until they are done, the
+    // window and the result of the node are updated with theirs
+    void split(
+        SearchThread& thread, Board& board, MovePicker& picker, int depth, int ply, int move_count,
+        bool in_check, bool pv_node, int& alpha, int& beta, int& best_score, Move& best_move
+    );
+
+    // Search the move of a task and add its score to the split point
+    void run_task(SearchThread& thread, const Task& task);
+
+    // Take the oldest task of another thread. Given a split point, only a task of a split point
+    // below it, i.e. one of the threads working on its tasks
+    std::optional<Task> steal_task(SearchThread& thread, const SplitPoint* below);
+
+    // Loop of an idle thread of a parallel search, taking the tasks of the others until the search is done
+    void steal_tasks(SearchThread& thread);
+
+    // Check if passing the turn is a sound test for the node: not in check and not a pawn endgame
+    // of the player to move, where passing would be better than any move (zugzwang)
+    static bool null_move_allowed(const Board& board);
+
+    // Remember a quiet move that caused a cutoff for the ordering of later nodes
+    void update_quiet_statistics(SearchThread& thread, const Board& board, const Move& move, int depth, int ply);
+
+    // Forget the killer moves and the history of an earlier search
+    void clear_move_ordering(SearchThread& thread);
+
+    // Search of the captures and promotions below the leaves, until the position is quiet
+    int quiescence(SearchThread& thread, Board& board, int alpha, int beta);
+
+    // Count a node, once the hard deadline has passed the search is stopped
+    void count_node(SearchThread& thread);
+
+    // One iteration over the root moves within the aspiration window, sorts them best first.
+    // Returns the best score, a bound outside the window if the iteration has to be repeated
+    int search_root(SearchThread& thread, Board& board, int depth, int margin, std::vector<RootMove>& root_moves, int alpha, int beta);
+
+    // Line of best moves stored in the table, starting at the given board
+    std::vector<Move> principal_variation(Board board, int depth) const;
 };
 
 #endif
\ No newline at end of file
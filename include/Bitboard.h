@@ -0,0 +1,101 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "Types.h"
+
+// 64-bit set of squares, bit index = row * 8 + column
+using Bitboard = std::uint64_t;
+
+// Masks for the edge columns, used to stop shifts from wrapping around the board
+constexpr Bitboard COLUMN_0 = 0x0101010101010101ULL;
+constexpr Bitboard COLUMN_7 = 0x8080808080808080ULL;
+constexpr Bitboard ROW_0 = 0x00000000000000FFULL;
+constexpr Bitboard ROW_7 = 0xFF00000000000000ULL;
+
+// Convert board coordinates to a square index
+constexpr int square(int row, int col) {
+    return row * 8 + col;
+}
+
+// Convert a square index back to board coordinates
+constexpr std::array<int, 2> position(int square) {
+    return {square / 8, square % 8};
+}
+
+// Bitboard with only the given square set
+constexpr Bitboard square_bb(int square) {
+    return Bitboard(1) << square;
+}
+
+// Number of squares in the set
+inline int count_squares(Bitboard bb) {
+    return std::popcount(bb);
+}
+
+// Index of the lowest square in a non-empty set
+inline int lowest_square(Bitboard bb) {
+    return std::countr_zero(bb);
+}
+
+// Remove and return the lowest square of a non-empty set
+inline int pop_square(Bitboard& bb) {
+    int square = std::countr_zero(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+// Precomputed attacks for the non-sliding pieces
+extern const std::array<Bitboard, 64> KNIGHT_ATTACKS;
+extern const std::array<Bitboard, 64> KING_ATTACKS;
+extern const std::array<std::array<Bitboard, 64>, 2> PAWN_ATTACKS;
+
+// Squares attacked by a whole set of pawns of the given player
+inline Bitboard pawn_attacks(Bitboard pawns, PlayerColor player) {
+    if (player == white) {
+        return ((pawns & ~COLUMN_7) << 9) | ((pawns & ~COLUMN_0) << 7);
+    }
+    return ((pawns & ~COLUMN_7) >> 7) | ((pawns & ~COLUMN_0) >> 9);
+}
+
+// Magic bitboard entry of a single square for one kind of slider.
+// The occupied squares on the relevant rays are hashed by a multiplication
+// into an index of the square's slice of the shared attack table.
+struct Magic {
+    Bitboard mask; // Relevant occupancy (the rays without their last square)
+    Bitboard magic; // Multiplier mapping every occupancy subset to a unique slot
+    const Bitboard* attacks; // Attack sets of this square, indexed by index()
+    unsigned shift; // 64 minus the number of relevant squares
+
+    unsigned index(Bitboard occupied) const {
+        return unsigned(((occupied & mask) * magic) >> shift);
+    }
+};
+
+extern std::array<Magic, 64> ROOK_MAGICS;
+extern std::array<Magic, 64> BISHOP_MAGICS;
+
+// Squares strictly between two squares on a common line (empty if not aligned)
+extern std::array<std::array<Bitboard, 64>, 64> BETWEEN;
+// Whole line through two aligned squares, edge to edge (empty if not aligned)
+extern std::array<std::array<Bitboard, 64>, 64> LINE;
+
+// Attacks of the sliding pieces for the given occupancy
+inline Bitboard rook_attacks(int square, Bitboard occupied) {
+    const Magic& entry = ROOK_MAGICS[square];
+    return entry.attacks[entry.index(occupied)];
+}
+
+inline Bitboard bishop_attacks(int square, Bitboard occupied) {
+    const Magic& entry = BISHOP_MAGICS[square];
+    return entry.attacks[entry.index(occupied)];
+}
+
+inline Bitboard queen_attacks(int square, Bitboard occupied) {
+    return rook_attacks(square, occupied) | bishop_attacks(square, occupied);
+}
+
+#endif
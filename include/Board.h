@@ -4,40 +4,68 @@
 #include <iostream>
 #include <array>
 #include <algorithm>
+#include <expected>
 #include <functional>
+#include <optional>
 #include <random>
 #include <span>
+#include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include "Types.h"
+#include "Bitboard.h"
+#include "Move.h"
 #include "Piece.h"
 
 class Piece;
 class Game;
 
+// State needed to take back a move made with Board::make_move
+struct UndoRecord {
+    Move move; // The move that was made
+    Piece piece; // Moved piece (before a promotion)
+    Piece captured; // Captured piece, empty if none
+    int captured_square; // Square of the captured piece (differs from the destination for en passant)
+    std::uint8_t castling; // Castling rights before the move
+    std::array<int, 2> enpassant; // En passant square before the move
+    Winner winner; // Game result before the move
+    std::uint64_t zobrist_key; // Position key before the move
+};
+
 class Board {
 public:
     // Dimensions of the chessboard
-    const int ROWS = 8;
-    const int COLS = 8;
+    static constexpr int ROWS = 8;
+    static constexpr int COLS = 8;
 
     // Board state attributes
     PlayerColor turn; // Current player's turn (white = 0 or black = 1)
-    std::string castling; // Castling rights (e.g., "KQkq")
+    std::uint8_t castling; // Castling rights still available (CastlingRight bits)
     std::array<int, 2> enpassant; // Coordinates for en passant, if available
 
-    // 2D array of unique pointers to Piece objects
-    std::array<std::array<std::unique_ptr<Piece>, 8>, 8> board;
+    // Bitboards of every piece kind, indexed by Piece::index() (player * 6 + piece type).
+    // Together with occupancy they are the per-side piece lists, kept up to date by every move
+    std::array<Bitboard, 12> pieces;
+    std::array<Bitboard, 2> occupancy; // Squares occupied by each player
+    Bitboard occupied; // Squares occupied by any piece
+
+    // Piece standing on each square (an empty Piece if the square is empty)
+    std::array<Piece, 64> board;
+
+    // Legal moves of the player to move
+    MoveList legal_moves;
 
     // Chessboard analysis data
-    PositionSet attacked_positions; // Positions attacked by the opponent
-    PositionMap checkin_pieces; // Pieces causing a check on the king
-    PositionMap pinned_pieces; // Pieces pinned to the king
-    PositionSet active_pieces;
+    Bitboard attacked; // Squares attacked by the opponent (sliders see through the king)
+    Bitboard checkers; // Opponent pieces giving check to the king
+    Bitboard check_mask; // Squares resolving the check (every square if not in check, none in double check)
+    Bitboard pinned; // Pieces of the player to move pinned to their king
 
     // Board evaluation ratings and weights
-    const int material_rating_weight = 50;
-    const int attack_rating_weight = 3;
-    const int protecting_rating_weight = 2;
+    static constexpr int material_rating_weight = 50;
+    static constexpr int attack_rating_weight = 3;
+    static constexpr int protecting_rating_weight = 2;
 
     int white_material_rating;
     int black_material_rating;
@@ -63,25 +91,8 @@ public:
         const std::array<std::array<char, 8>, 8>& simplify_board
     );
 
-    // Custom destructor (not necessary)
-    ~Board() {
-        for (int i = 0; i < ROWS; ++i) {
-            for (int j = 0; j < COLS; ++j) {
-                board[i][j].reset();
-            }
-        }
-
-        attacked_positions.clear();
-        checkin_pieces.clear();
-        pinned_pieces.clear();
-        active_pieces.clear();
-    }
-    
-    // Copy constructor
-    Board(const Board& other_board);
-
-    // Assignment operator
-    Board& operator=(const Board& other_board);
+    // Create a board from a position in Forsyth-Edwards Notation
+    static std::expected<Board, std::string> from_fen(const std::string& fen);
 
     // Reset the board to its initial state
     void reset();
@@ -94,14 +105,60 @@ public:
     friend std::ostream& operator<<(std::ostream& out, const Board& board_class);
 
     // Initialize the board with the standard starting position
-    std::array<std::array<std::unique_ptr<Piece>, 8>, 8> create_board() const;
+    void create_board();
 
     // Initialize the board with a custom configuration
-    std::array<std::array<std::unique_ptr<Piece>, 8>, 8> create_board(const std::array<std::array<char, 8>, 8>& simplify_board) const;
+    void create_board(const std::array<std::array<char, 8>, 8>& simplify_board);
+
+    // Castling rights as text, "KQkq" with '_' for every right that is gone
+    std::string castling_string() const;
+
+    // Symbol of the piece on the given square (' ' if the square is empty)
+    char get_symbol(int row, int col) const;
+
+    // Possible actions of the piece on the given square, built from the legal moves
+    Actions get_actions(int row, int col) const;
+
+    // 64-bit Zobrist key of the position (pieces, side to move, castling rights, en passant)
+    std::uint64_t hash() const {return zobrist_key;}
+
+    // Bitboard of the given piece kind
+    Bitboard get_pieces(PieceType piece, PlayerColor player) const {
+        return pieces[player * 6 + piece];
+    }
+
+    // Check if the square is attacked by any piece of the given player
+    bool is_attacked(int square, PlayerColor by) const;
+
+    // Static exchange evaluation: material won by the move (in Piece::get_value units) when both
+    // players keep recapturing on its destination with their least valuable attacker, each
+    // stopping as soon as recapturing would lose. Pins are not considered
+    int see(const Move& move) const;
+
+    // Squares the piece on the given square may move to without uncovering its king
+    Bitboard pin_mask(int square) const {
+        if (!(pinned & square_bb(square))) return ~Bitboard(0);
+        return LINE[lowest_square(get_pieces(king, turn))][square];
+    }
 
     // Calculate all possible moves for the current player
     void get_possible_actions();
 
+    // Calculate the captures and queen promotions of the current player for the quiescence
+    // search, every legal move when in check (the winner is not updated)
+    void get_possible_captures();
+
+    // Checks, pins and the squares attacked by the opponent, needed by move generation and rating
+    void update_analysis();
+
+    // Add the legal moves of the given type to the legal moves, for generating them in stages
+    // (requires update_analysis, the winner is not updated)
+    void add_legal_moves(GenerationType type);
+
+    // Check if the move is legal, for moves that were not generated in this position
+    // (requires update_analysis, the legal moves are left as they were)
+    bool is_legal(const Move& move);
+
     // Calculate the rating of the board
     void get_rating();
 
@@ -119,41 +176,70 @@ public:
         const Actions& possible_actions
     ) const;
 
-    void apply_move(Board& target_board, int old_row, int old_col, int new_row, int new_col, char symbol) const;
+    // Find the legal move matching the given squares (symbol picks the promotion piece)
+    std::optional<Move> find_move(int old_row, int old_col, int new_row, int new_col, char symbol) const;
+
+    // Make a legal move in place and return the record needed to take it back
+    UndoRecord make_move(const Move& move);
+
+    // Take back a move made with make_move (possible actions are not restored)
+    void unmake_move(const UndoRecord& undo);
+
+    // Pass the turn to the opponent without moving (null move pruning of the search)
+    UndoRecord make_null_move();
+    void unmake_null_move(const UndoRecord& undo);
 
     // Execute a move on the board
     void make_action(int old_row, int old_col, int new_row, int new_col, char symbol);
 
-    // Generate a new board after a move (AlfaBetaPruning)
+    // Generate a new board after a move
     Board make_action_board(int old_row, int old_col, int new_row, int new_col, char symbol) const;
 
-    // Generate AI move
+    // Generate AI move (nothing happens if the player to move has no legal move)
     void computer_action(Game& game);
 
 private:
-    // Helper functions for creating pieces
-    std::unique_ptr<Piece> create_piece(
-        char symbol,
-        int row,
-        int col
-    ) const;
+    // Zobrist key, updated incrementally with every change of the position
+    std::uint64_t zobrist_key;
 
-    // Flattens all checking positions into an unordered set for faster lookups
-    PositionSet flatting_checkin_pieces(
-        const PositionMap& checkin_pieces
-    ) const;
+    // Place, remove and move pieces keeping the bitboards and the square array in sync
+    void put_piece(Piece piece, int square);
+    void remove_piece(int square);
+    void move_piece(int from, int to);
+
+    // Pieces of both players attacking the square for the given occupancy
+    Bitboard attackers_to(int square, Bitboard occupied_squares) const;
+
+    // Squares attacked by all pieces of the given player for the given occupancy
+    Bitboard attacks_by(PlayerColor by, Bitboard occupied_squares) const;
+
+    // Add the legal moves and the piece ratings of the pieces, specialized for the side to move
+    template<PlayerColor Us, GenerationType Type> void generate_moves();
+    template<PlayerColor Us> void rate_pieces();
+
+    // Find the checking and pinned pieces with a single pass from the king square
+    void update_checks_and_pins();
+
+    // Castling rights (CastlingRight bits) from text such as "KQ__"
+    static std::uint8_t parse_castling(const std::string& castling);
 
     // Handle en passant logic during a move
     void check_enpassant(int old_row, int old_col, int new_row);
 
     // Handle castling logic during a move
-    void check_castling(int old_row, int old_col);
+    void check_castling(int row, int col);
 
     // Promote a pawn and create the promoted piece
-    std::unique_ptr<Piece> create_promoted_piece_player(int row, int col) const;
+    Piece create_promoted_piece_player() const;
+
+    // Symbol of the piece the player to move promotes to (' ' if the move is not a promotion)
+    char promotion_symbol(const Move& move) const;
 
     // Select a random action from a set of best possible actions
     Action get_random_element(std::span<const Action> best_actions) const;
 };
 
-#endif
\ No newline at end of file
+// Boards are copied on every search branch, a plain memberwise copy keeps that cheap
+static_assert(std::is_trivially_copyable_v<Board>);
+
+#endif
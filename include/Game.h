@@ -19,6 +19,7 @@ public:
     std::array<int, 2> last_move_ending; // Ending position of the last move
 
     AlfaBetaPruning alfa_beta_pruning; // AI logic
+    SearchLimits search_limits; // Depth and time limits of every AI move
 
     // Singleton instance access
     static Game& get_instance() {
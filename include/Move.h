@@ -0,0 +1,93 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "Types.h"
+
+// Kind of a move, stored in the two highest bits of Move
+enum MoveFlag {
+    normal_move,
+    promotion_move,
+    enpassant_move,
+    castling_move
+};
+
+// Moves produced by the move generator
+enum GenerationType {
+    all_moves,
+    captures, // Captures and queen promotions, as searched by the quiescence search
+    quiets // Every other move: quiet moves, castling and underpromotions
+};
+
+// Move packed into 16 bits:
+// bits 0-5 starting square, bits 6-11 destination square,
+// bits 12-13 promotion piece (rook, knight, bishop, queen), bits 14-15 MoveFlag
+class Move {
+public:
+    // Uninitialized on purpose so that a MoveList can be created without clearing it
+    Move() = default;
+
+    constexpr Move(int from, int to, MoveFlag flag = normal_move, PieceType promotion = queen)
+        : data(std::uint16_t(from | (to << 6) | ((promotion - rook) << 12) | (flag << 14))) {}
+
+    constexpr int from() const {return data & 0x3F;}
+    constexpr int to() const {return (data >> 6) & 0x3F;}
+    constexpr MoveFlag flag() const {return MoveFlag(data >> 14);}
+    constexpr PieceType promotion() const {return PieceType(((data >> 12) & 0x3) + rook);}
+
+    constexpr bool operator==(const Move& other) const = default;
+
+    // Coordinate notation of the move (e.g. "e2e4", "e7e8q")
+    std::string uci() const {
+        // Columns are counted from the h-file
+        std::string text = {
+            char('h' - from() % 8), char('1' + from() / 8),
+            char('h' - to() % 8), char('1' + to() / 8)
+        };
+        if (flag() == promotion_move) {
+            text += " rnbq"[promotion()];
+        }
+        return text;
+    }
+
+private:
+    std::uint16_t data;
+};
+
+static_assert(sizeof(Move) == 2);
+
+// Placeholder for "no move" (a move always changes the square of the piece)
+inline constexpr Move NO_MOVE(0, 0);
+
+// Fixed-capacity list of moves living on the stack (no position has more than 218 legal moves)
+class MoveList {
+public:
+    void push_back(const Move& move) {moves[count++] = move;}
+    void clear() {count = 0;}
+    void resize(int size) {count = size;} // Only to drop moves from the end
+
+    int size() const {return count;}
+    bool empty() const {return count == 0;}
+
+    const Move& operator[](int index) const {return moves[index];}
+    Move& operator[](int index) {return moves[index];}
+
+    const Move* begin() const {return moves.data();}
+    const Move* end() const {return moves.data() + count;}
+    Move* begin() {return moves.data();}
+    Move* end() {return moves.data() + count;}
+
+    bool operator==(const MoveList& other) const {
+        return count == other.count && std::equal(begin(), end(), other.begin());
+    }
+
+private:
+    std::array<Move, 256> moves;
+    int count = 0;
+};
+
+#endif
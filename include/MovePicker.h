@@ -0,0 +1,84 @@
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include <array>
+
+#include "Board.h"
+#include "Move.h"
+
+// Butterfly table: how often a quiet move caused a cutoff, indexed by player, starting and destination square
+using HistoryTable = std::array<std::array<std::array<int, 64>, 64>, 2>;
+
+// Quiet moves that caused a cutoff at the same ply of the search, the most recent first
+using KillerMoves = std::array<Move, 2>;
+
+// Hands out the legal moves of a position best first, generating them in stages: the hash move,
+// the good captures and queen promotions by MVV-LVA, the killer moves, the quiet moves by their
+// history and last the captures that lose material by static exchange evaluation. A stage is
+// only generated once the previous one is exhausted, so a cutoff by an early move saves
+// generating the rest.
+class MovePicker {
+public:
+    // Moves already generated in board.legal_moves (quiescence search), ordered by MVV-LVA only
+    explicit MovePicker(const Board& board);
+
+    // Staged moves of the search, the board must be analysed (Board::update_analysis) and be
+    // back in the same position at every call of next()
+    MovePicker(Board& board, Move hash_move, const KillerMoves& killers, const HistoryTable& history);
+
+    // Next best move, NO_MOVE when all moves have been picked
+    Move next();
+
+    // Captures (including en passant) and queen promotions, the moves of the captures stage and
+    // of the quiescence search
+    static bool is_tactical(const Board& board, const Move& move);
+
+    // Most valuable victim first, the least valuable attacker first among equal victims
+    static int mvv_lva(const Board& board, const Move& move);
+
+private:
+    enum Stage {
+        hash_stage,
+        generate_captures_stage,
+        captures_stage,
+        killers_stage,
+        generate_quiets_stage,
+        quiets_stage,
+        bad_captures_stage,
+        all_stage, // The single stage of the quiescence search
+        done_stage
+    };
+
+    Board* board;
+    bool analysed; // The analysis of the board is its own, not left over from a searched child
+    const HistoryTable* history;
+    Move hash_move;
+    KillerMoves killers;
+    Stage stage;
+
+    // Moves and scores of the current stage, handed out from current up to the end
+    MoveList moves;
+    std::array<int, 256> scores;
+    int current = 0;
+
+    // Captures put aside by the captures stage
+    MoveList bad_captures;
+    int current_bad = 0;
+
+    // Analyse the board again if moves were made on it since the last analysis
+    void refresh_analysis();
+
+    // Copy the legal moves of the board into the current stage
+    void load_stage(GenerationType type);
+
+    // Next move of the stages, generating them as needed
+    Move pick_next();
+
+    // Best remaining move of the current stage, NO_MOVE when the stage is exhausted
+    Move pick_best();
+
+    // Moves that were already handed out by an earlier stage
+    bool is_special(const Move& move) const;
+};
+
+#endif
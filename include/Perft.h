@@ -0,0 +1,16 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <cstdint>
+#include <iostream>
+
+#include "Board.h"
+
+// Count the leaf nodes of the legal move tree of the given depth (performance test of the move generator).
+// A depth of 0 or below is a leaf
+std::uint64_t perft(Board& board, int depth);
+
+// Perft split by the first move, printing the count of every root move ("divide")
+std::uint64_t perft_divide(Board& board, int depth, std::ostream& out);
+
+#endif
\ No newline at end of file
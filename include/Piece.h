@@ -1,337 +1,153 @@
 #ifndef PIECE_H
 #define PIECE_H
 
-#include <string>
-#include <unordered_map>
-#include <array>
-#include <unordered_set>
-#include <utility>
+#include <cstdint>
+#include <iostream>
 
 #include "Types.h"
+#include "Bitboard.h"
 
 // Forward declaration of the Board class
 class Board;
 
-// Base class representing a generic chess piece
+// Chess piece packed into a single byte: piece type + 1 in bits 0-2, player in bit 3.
+// A default-constructed piece is an empty square. Pieces are plain values, the
+// piece-specific logic is selected with a switch on the piece type.
 class Piece {
 public:
-    char symbol; // Character symbol representing the piece (e.g., 'P' for pawn)
-    PieceType piece; // Name of the piece (e.g., "pawn")
-    PlayerColor player; // Player owning the piece ("white" or "black")
-    int row; // Row position of the piece on the board
-    int column; // Column position of the piece on the board
-    Actions possible_actions; // Stores the possible actions for the piece
-
-    // Constructor
-    Piece(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        const int& input_row,
-        const int& input_column
-    );
-
-    virtual ~Piece() = default;
+    // Empty square
+    constexpr Piece() = default;
 
-    // Comparison operators for equality and inequality
-    bool operator==(const Piece& other) const;
-    bool operator!=(const Piece& other) const;
-
-    // Overloaded output stream operator for Piece
-    friend std::ostream& operator<<(std::ostream& out, const Piece& piece);
-
-    // Allows Board class to access private/protected members of Piece
-    friend class Board;
-
-protected:
-    // Check if a position is within the board bounds
-    bool is_valid_position(const Board& board, const int& row, const int& column) const;
-
-    // Checks if moving the piece will not expose the king to a check (i.e., the piece is not pinned)
-    bool is_not_pinned(
-        const std::array<int, 2>& piece_position,
-        const std::array<int, 2>& move,
-        const Board& board_class,
-        const PositionMap& pinned_pieces
-    ) const;
-
-    // Helper methods for rook, bishop, and queen movement logic
-    void rook_bishop_queen_move_template_active_player (
-        Board& board_class,
-        const std::vector<std::array<int, 2>>& directions
-    ) const;
+    constexpr Piece(PieceType input_piece, PlayerColor input_player)
+        : data(std::uint8_t((input_piece + 1) | (input_player << 3))) {}
 
-    void rook_bishop_queen_move_template_opponent (
-        Board& board_class,
-        const std::vector<std::array<int, 2>>& directions,
-        const PositionSet& checking_positions
-    );
+    PieceType piece() const {return PieceType((data & 7) - 1);} // Type of the piece (e.g., pawn)
+    PlayerColor player() const {return PlayerColor(data >> 3);} // Player owning the piece
 
-    void rook_bishop_queen_rating_template_active_player (
-        Board& board_class,
-        const std::vector<std::array<int, 2>>& directions
-    );
-
-    void rook_bishop_queen_rating_template_opponent (
-        Board& board_class,
-        const std::vector<std::array<int, 2>>& directions,
-        const PositionSet& checking_positions
-    );
+    // Character symbol representing the piece (e.g., 'P' for a white pawn, ' ' for an empty square)
+    char symbol() const;
 
-    // Pure virtual function to determine piece-specific possible moves
-    virtual void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) = 0;
-
-    virtual void check_piece_possible_moves_active_player (
-        Board& board_class,
-        const PositionSet& checking_positions
-    ) = 0;
+    // Index of the piece's bitboard in Board::pieces
+    int index() const {return player() * 6 + piece();}
 
     // Get the point value of the piece
-    virtual int const get_value() const = 0;
-    
-    // Validate if a given action is legal for the piece
-    bool check_if_legal_action(int check_row, int check_col);
-
-    // Virtual functions to update the piece's rating during gameplay
-    virtual void update_rating_opponent (
-        Board& board_class
-    ) = 0;
+    int get_value() const;
 
-    virtual void update_rating_active_player (
-        Board& board_class,
-        const PositionSet& checking_positions
-    ) = 0;
+    // False for an empty square
+    explicit constexpr operator bool() const {return data != 0;}
 
-    // Helper to update ratings for moves aiding a player
-    void update_move_rating_helping (
-        Board& board_class,
-        const PlayerColor& player,
-        int row,
-        int col
-    );
-};
+    // Comparison operators for equality and inequality
+    constexpr bool operator==(const Piece& other) const = default;
 
-// Derived class representing a Pawn
-class Pawn: public Piece {
-public:
-    Pawn(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
+    // Overloaded output stream operator for Piece
+    friend std::ostream& operator<<(std::ostream& out, const Piece& piece);
 
-private:
-    // Implements pawn-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+    // Piece for the given symbol, an empty square for any other character
+    static Piece get_piece(char symbol);
 
-    // Implements pawn-specific move logic for the active player's turn
-    void check_piece_possible_moves_active_player (
-        Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
+    // Allows Board class to access private members of Piece
+    friend class Board;
 
-    // Update the rating of the pawn for the opponent
-    void update_rating_opponent (
-        Board& board_class
-    ) override;
+private:
+    std::uint8_t data = 0;
 
-    // Update the rating of the pawn for the active player
-    void update_rating_active_player (
-        Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-    
-    // Returns the point value of a pawn
-    int const get_value() const override {return 1;};
-};
+    // Piece-specific logic is templated on the piece's player, so that the colour
+    // dependent constants (pawn direction, castling rights, rating sign) fold at
+    // compile time. Board picks the side to move once per node.
 
-// Derived class representing a Knight
-class Knight: public Piece {
-public:
-    Knight(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
+    // Squares attacked by the piece standing on the given square
+    template<PlayerColor Us>
+    Bitboard attacks(const Board& board_class, int square) const;
 
-private:
-    // Implements knight-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+    // Squares the piece may move to without leaving the king in check (pins and check evasions)
+    Bitboard legal_targets(
+        const Board& board_class,
+        int square
+    ) const;
 
-    // Implements knight-specific move logic for the active player's turn
+    // Add the legal moves of the piece for the active player's turn (only the captures if Type is captures)
+    template<PlayerColor Us, GenerationType Type>
     void check_piece_possible_moves_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
+        int square
+    ) const;
 
-    // Update the rating of the knight for the opponent
+    // Update the piece's rating for the opponent and for the active player
+    template<PlayerColor Us>
     void update_rating_opponent (
-        Board& board_class
-    ) override;
+        Board& board_class,
+        int square
+    ) const;
 
-    // Update the rating of the knight for the active player
+    template<PlayerColor Us>
     void update_rating_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Returns the point value of a knight
-    int const get_value() const override {return 3;};
-};
-
-// Derived class representing a King
-class King: public Piece {
-public:
-    King(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
-
-private:
-    // Implements king-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+        int square
+    ) const;
 
-    // Implements king-specific move logic for the active player's turn
-    void check_piece_possible_moves_active_player (
+    // Helper methods for rook, bishop, queen and knight movement and rating logic
+    template<PlayerColor Us, GenerationType Type>
+    void rook_bishop_queen_move_template_opponent (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Update the rating of the king for the opponent
-    void update_rating_opponent (
-        Board& board_class
-    ) override;
+        int square,
+        Bitboard attacks
+    ) const;
 
-    // Update the rating of the king for the active player
-    void update_rating_active_player (
+    template<PlayerColor Us>
+    void rook_bishop_queen_rating_template_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Returns the point value of a king
-    int const get_value() const override {return 50;};
-};
-
-// Derived class representing a Rook
-class Rook: public Piece {
-public:
-    Rook(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
-
-private:
-    // Implements rook-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+        Bitboard attacks
+    ) const;
 
-    // Implements rook-specific move logic for the active player's turn
-    void check_piece_possible_moves_active_player (
+    template<PlayerColor Us>
+    void rook_bishop_queen_rating_template_opponent (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Update the rating of the rook for the opponent
-    void update_rating_opponent (
-        Board& board_class
-    ) override;
+        int square,
+        Bitboard attacks
+    ) const;
 
-    // Update the rating of the rook for the active player
-    void update_rating_active_player (
+    // Pawn-specific move and rating logic for the active player's turn
+    template<PlayerColor Us, GenerationType Type>
+    void pawn_possible_moves_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Returns the point value of a rook
-    int const get_value() const override {return 5;};
-};
-
-// Derived class representing a Bishop
-class Bishop: public Piece {
-public:
-    Bishop(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
-
-private:
-    // Implements bishop-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+        int square
+    ) const;
 
-    // Implements bishop-specific move logic for the active player's turn
-    void check_piece_possible_moves_active_player (
+    template<PlayerColor Us>
+    void pawn_rating_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
+        int square
+    ) const;
 
-    // Update the rating of the bishop for the opponent
-    void update_rating_opponent (
-        Board& board_class
-    ) override;
+    // Checks that capturing en passant does not uncover an attack on the king
+    template<PlayerColor Us>
+    bool is_enpassant_safe(
+        const Board& board_class,
+        int square,
+        int target
+    ) const;
 
-    // Update the rating of the bishop for the active player
-    void update_rating_active_player (
+    // King-specific move and rating logic for the active player's turn
+    template<PlayerColor Us, GenerationType Type>
+    void king_possible_moves_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Returns the point value of a bishop
-    int const get_value() const override {return 3;};
-};
-
-// Derived class representing a Queen
-class Queen: public Piece {
-public:
-    Queen(const char& input_symbol,
-        const PieceType& input_piece,
-        const PlayerColor& input_player,
-        int input_row,
-        int input_column
-    );
-
-private:
-    // Implements queen-specific move logic for the opponent's turn
-    void check_piece_possible_moves_opponent (
-        Board& board_class
-    ) override;
+        int square
+    ) const;
 
-    // Implements queen-specific move logic for the active player's turn
-    void check_piece_possible_moves_active_player (
+    template<PlayerColor Us>
+    void king_rating_active_player (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Update the rating of the queen for the opponent
-    void update_rating_opponent (
-        Board& board_class
-    ) override;
+        int square
+    ) const;
 
-    // Update the rating of the queen for the active player
-    void update_rating_active_player (
+    // Helper to update the rating of player Us for a square its piece reaches
+    template<PlayerColor Us>
+    void update_move_rating_helping (
         Board& board_class,
-        const PositionSet& checking_positions
-    ) override;
-
-    // Returns the point value of a queen
-    int const get_value() const override {return 9;};
+        int square
+    ) const;
 };
 
-#endif
\ No newline at end of file
+static_assert(sizeof(Piece) == 1);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads kept alive between searches, so that starting parallel work does
+// not create threads. A job is run once on every worker at the same time, the workers sleep on
+// atomic waits in between.
+class ThreadPool {
+public:
+    explicit ThreadPool(int count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of worker threads
+    int size() const {return int(workers.size());}
+
+    // Run the job on every worker with the worker's index (0 to size() - 1) and return at once.
+    // The previous job has to be finished (wait)
+    void start(std::function<void(int)> new_job);
+
+    // Block until every worker has finished the current job
+    void wait();
+
+private:
+    std::vector<std::thread> workers;
+
+    std::function<void(int)> job; // Only replaced while no worker is running it
+    std::atomic<std::uint64_t> generation = 0; // Incremented with every job, wakes the workers
+    std::atomic<int> running = 0; // Workers still running the current job
+    std::atomic<bool> exiting = false;
+
+    // Wait for jobs and run them until the pool is destroyed
+    void worker_loop(int index);
+};
+
+#endif
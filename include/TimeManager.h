@@ -0,0 +1,52 @@
+#ifndef TIMEMANAGER_H
+#define TIMEMANAGER_H
+
+#include <chrono>
+#include <cstdint>
+
+// Deepest iteration of a search that is only limited by time
+inline constexpr int MAX_SEARCH_DEPTH = 64;
+
+// Limits of a search. Times are in milliseconds, 0 means the limit is not set.
+// Without move_time and time the search only stops at the depth limit.
+struct SearchLimits {
+    int depth = MAX_SEARCH_DEPTH; // Deepest iteration
+    std::int64_t time = 0; // Time left on the clock of the player to move
+    std::int64_t increment = 0; // Time added to the clock after every move
+    int moves_to_go = 0; // Moves until the next time control, 0 if the time is for the rest of the game
+    std::int64_t move_time = 0; // Fixed time for this move, takes precedence over the clock
+};
+
+// Splits the time of the player to move into the budgets of a single move.
+// No new iteration is started after the soft budget, the search is aborted at the hard one.
+class TimeManager {
+public:
+    // Time kept in reserve for the communication and the move itself
+    static constexpr std::int64_t MOVE_OVERHEAD = 10;
+
+    // Number of moves the remaining time is split into when moves_to_go is not set
+    static constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+    // Start the clock of a new move and allocate its budgets
+    void start(const SearchLimits& limits);
+
+    // False if the search is only limited by depth
+    bool limited() const {return time_limited;}
+
+    // Milliseconds since start
+    std::int64_t elapsed() const;
+
+    bool soft_expired() const {return time_limited && elapsed() >= soft;}
+    bool hard_expired() const {return time_limited && elapsed() >= hard;}
+
+    std::int64_t soft_budget() const {return soft;}
+    std::int64_t hard_budget() const {return hard;}
+
+private:
+    std::chrono::steady_clock::time_point start_time;
+    bool time_limited = false;
+    std::int64_t soft = 0;
+    std::int64_t hard = 0;
+};
+
+#endif
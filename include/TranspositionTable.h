@@ -0,0 +1,86 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Move.h"
+
+// How the stored score relates to the true score of the position
+enum Bound : std::uint8_t {
+    no_bound,
+    upper_bound, // The search failed low, the true score is at most the stored one
+    lower_bound, // The search failed high, the true score is at least the stored one
+    exact_bound
+};
+
+// Result of an earlier search of a position (16 bytes)
+struct TTEntry {
+    std::uint64_t key; // Zobrist key of the position
+    std::int32_t score; // Score from white's point of view
+    Move best_move; // Best (or refuting) move found, NO_MOVE if there is none
+    std::int8_t depth; // Remaining depth the position was searched to
+    std::uint8_t age_bound; // Search age in the upper 6 bits, Bound in the lower 2 bits
+
+    Bound bound() const {return Bound(age_bound & 0x3);}
+    std::uint8_t age() const {return age_bound >> 2;}
+};
+
+// Fixed-size hash table of searched positions, shared by all nodes and all threads of the search.
+// Entries are grouped in cache-line sized buckets selected by the lowest bits of the key.
+// The table is lock-free: an entry is stored as two atomic words, the key xor-ed with the data
+// and the data, so that an entry torn by two threads writing it at once fails the key check.
+class TranspositionTable {
+public:
+    // Number of entries in a bucket
+    static constexpr int BUCKET_SIZE = 4;
+
+    explicit TranspositionTable(std::size_t megabytes = 16);
+
+    // Reallocate the table with the largest power-of-two bucket count that fits the size (clears it)
+    void resize(std::size_t megabytes);
+
+    // Remove all entries (not while a search is running)
+    void clear();
+
+    // Start a new search, entries of older searches become preferred for replacement
+    void new_search();
+
+    // Copy of the entry of the position, empty if it is not stored
+    std::optional<TTEntry> probe(std::uint64_t key) const;
+
+    // Store the result of a search, replacing the shallowest and oldest entry of the bucket
+    void store(std::uint64_t key, int depth, Bound bound, int score, Move best_move);
+
+    // Number of buckets (a power of two)
+    std::size_t bucket_count() const {return buckets.size();}
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> key; // Zobrist key xor data
+        std::atomic<std::uint64_t> data; // Score, best move, depth and age_bound of TTEntry
+    };
+
+    struct alignas(64) Bucket {
+        std::array<Slot, BUCKET_SIZE> slots;
+    };
+
+    std::vector<Bucket> buckets;
+    std::uint8_t age = 0;
+
+    const Bucket& bucket(std::uint64_t key) const {return buckets[key & (buckets.size() - 1)];}
+    Bucket& bucket(std::uint64_t key) {return buckets[key & (buckets.size() - 1)];}
+
+    // Entry held by a slot, its key is only valid if the slot was written in one piece
+    static TTEntry load(const Slot& slot);
+
+    // Data word of an entry
+    static std::uint64_t pack(const TTEntry& entry);
+};
+
+#endif
\ No newline at end of file
@@ -35,6 +35,11 @@ enum PlayerColor {
     black
 };
 
+// The other player
+constexpr PlayerColor opponent_of(PlayerColor player) {
+    return (player == white) ? black : white;
+}
+
 // Enum representing chess piece types
 enum PieceType {
     pawn,
@@ -45,6 +50,14 @@ enum PieceType {
     king
 };
 
+// Castling rights, one bit each in Board::castling (in the order of "KQkq")
+enum CastlingRight {
+    white_kingside = 1,
+    white_queenside = 2,
+    black_kingside = 4,
+    black_queenside = 8
+};
+
 // Enum representing the game's outcome
 enum Winner {
     whiteWin,
@@ -72,13 +85,13 @@ struct Actions {
     class Iterator{
     private:
         const Actions& container;
-        PositionSet::iterator current;
+        PositionSet::const_iterator current;
         bool in_attacks;
 
     public:
         Iterator(
             const Actions& c,
-            const PositionSet::iterator& it,
+            const PositionSet::const_iterator& it,
             const bool& attacks_flag
         );
 
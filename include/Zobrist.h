@@ -0,0 +1,35 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+#include "Types.h"
+
+// Random keys XORed together into a 64-bit position key
+namespace Zobrist {
+    // One key per piece kind (Piece::index()) and square
+    extern const std::array<std::array<std::uint64_t, 64>, 12> PIECES;
+    // Toggled when black is to move
+    extern const std::uint64_t BLACK_TO_MOVE;
+    // One key per castling right, in the order of Board::castling ("KQkq")
+    extern const std::array<std::uint64_t, 4> CASTLING;
+    // One key per column of the en passant square
+    extern const std::array<std::uint64_t, 8> ENPASSANT;
+
+    // Combined key of the castling rights that are still available (CastlingRight bits)
+    inline std::uint64_t castling_key(std::uint8_t castling) {
+        std::uint64_t key = 0;
+        for (int i = 0; i < 4; i++) {
+            if (castling & (1 << i)) key ^= CASTLING[i];
+        }
+        return key;
+    }
+
+    // Key of the en passant square (0 when there is none)
+    inline std::uint64_t enpassant_key(const std::array<int, 2>& enpassant) {
+        return enpassant[1] < 8 ? ENPASSANT[enpassant[1]] : 0;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,13 +1,732 @@
+#include <cmath>
+#include <optional>
+#include <thread>
+
 #include "AlfaBeta.h"
 
+AlfaBetaPruning::AlfaBetaPruning(std::size_t table_megabytes)
+    : transposition_table(table_megabytes),
+      threads(1) {
+    clear_move_ordering(threads[0]);
+}
+
 int AlfaBetaPruning::operator()(Board board, int depth, int alpha, int beta) {
-    board.get_possible_actions(); // Generate all possible moves for the current board state
+    // A plain search has no deadline
+    can_stop = false;
+    stopped = false;
+    for (SearchThread& thread : threads) {
+        thread.nodes = 0;
+        thread.stolen = 0;
+    }
+    if (!pool) return search(threads[0], board, depth, alpha, beta);
+
+    // The helper threads steal the brothers of the split points until the search is done
+    splitting = true;
+    search_done = false;
+    pool->start([this](int worker) {steal_tasks(threads[worker + 1]);});
+
+    int score = search(threads[0], board, depth, alpha, beta);
+
+    search_done = true;
+    pool->wait();
+    splitting = false;
+    return score;
+}
+
+SearchResult AlfaBetaPruning::iterative_deepening(Board board, const SearchLimits& limits, int margin) {
+    new_search();
+    time_manager.start(limits);
+    can_stop = true;
+    stopped = false;
+    for (SearchThread& thread : threads) {
+        clear_move_ordering(thread);
+        thread.nodes = 0;
+        thread.stolen = 0;
+    }
+
+    board.get_possible_actions();
+
+    SearchResult result;
+    std::vector<RootMove> root_moves;
+    for (const Move& move : board.legal_moves) {
+        root_moves.push_back({move, 0});
+    }
+    if (root_moves.empty()) return result;
+
+    int max_depth = std::min(limits.depth, MAX_SEARCH_DEPTH);
+
+    // The helper threads work from the start to the end of the search (see helper_search). With
+    // Young Brothers Wait switched on the nodes split and the helpers take their tasks
+    splitting = pool && young_brothers_wait;
+    if (pool) {
+        search_done = false;
+        root_depth = 1;
+        pool->start([this, board, max_depth](int worker) {
+            helper_search(threads[worker + 1], board, max_depth, worker + 1);
+        });
+    }
+
+    SearchThread& thread = threads[0];
+    int score = 0;
+    for (int depth = 1; depth <= max_depth; depth++) {
+        root_depth = depth;
+
+        // Aspiration window around the score of the previous iteration, widened while the score falls outside
+        int delta = ASPIRATION_WINDOW;
+        int alpha = -100000;
+        int beta = 100000;
+        if (depth > 1 && std::abs(score) < 100000) {
+            alpha = score - delta;
+            beta = score + delta;
+        }
+
+        while (true) {
+            // The root moves stay sorted by the previous iteration, the table holds its variation
+            score = search_root(thread, board, depth, margin, root_moves, alpha, beta);
+            if (stopped) break;
+
+            delta *= 2;
+            if (score <= alpha && alpha > -100000) {
+                alpha = std::max(-100000, score - delta);
+            } else if (score >= beta && beta < 100000) {
+                beta = std::min(100000, score + delta);
+            } else {
+                break;
+            }
+        }
+        if (stopped) break;
+
+        result.root_moves = root_moves;
+        result.depth = depth;
+        result.principal_variation = principal_variation(board, depth);
+
+        // The next iteration would most likely not finish in time
+        if (time_manager.soft_expired()) break;
+    }
+
+    // Even the first iteration was aborted, the first root move is played without a score
+    if (result.depth == 0) {
+        result.root_moves = {{root_moves[0].move, 0}};
+    }
+
+    // The result is the main thread's, the helpers are stopped wherever they are
+    if (pool) {
+        search_done = true;
+        pool->wait();
+    }
+    splitting = false;
+    for (const SearchThread& searched : threads) {
+        result.nodes += searched.nodes;
+    }
+    return result;
+}
+
+void AlfaBetaPruning::helper_search(SearchThread& thread, Board board, int max_depth, int index) {
+    int depth = 1;
+    while (!search_done) {
+        // The root moves after the first one are shared out among all threads
+        if (join_root_moves(thread)) continue;
+
+        // With Young Brothers Wait the helper takes the tasks of the split points of the others
+        if (splitting) {
+            if (std::optional<Task> task = steal_task(thread, nullptr)) {
+                run_task(thread, *task);
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        // Lazy SMP: the helper searches the root on its own. Half of the helpers are one ply
+        // ahead of the main thread, so that the threads spread over two depths. A helper done
+        // with its part of the root moves waits for the others
+        depth = std::max(depth, root_depth + index % 2);
+        if (depth > max_depth || root_job || aborted(thread)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        thread.lazy = true;
+        search(thread, board, depth, -100000, 100000);
+        bool completed = !aborted(thread);
+        thread.lazy = false;
+
+        // An iteration interrupted by the root moves is searched again, helped by the table
+        if (completed) depth++;
+    }
+}
+
+bool AlfaBetaPruning::join_root_moves(SearchThread& thread) {
+    // Idle helpers look here all the time, the lock is only taken for an open job
+    if (!root_job) return false;
+
+    const RootMovesJob* job;
+    {
+        std::lock_guard lock(root_mutex);
+        job = root_job;
+        if (!job || thread.root_job_number == root_job_number) return false;
+        thread.root_job_number = root_job_number;
+        root_workers++;
+    }
+
+    (*job)(thread);
+    root_workers--;
+    return true;
+}
+
+int AlfaBetaPruning::search_root(SearchThread& thread, Board& board, int depth, int margin, std::vector<RootMove>& root_moves, int alpha, int beta) {
+    bool maximizing = board.turn == white;
+
+    // The first move is expected to be the best one and gets the window. Meanwhile the helper
+    // threads search the root on their own and fill the table (Lazy SMP), or take the tasks of
+    // its split points when the nodes split
+    UndoRecord undo = board.make_move(root_moves[0].move);
+    int best = search(thread, board, depth - 1, alpha, beta, 1);
+    board.unmake_move(undo);
+
+    if (stopped) return 0;
+    root_moves[0].score = best;
+
+    // Outside of the aspiration window the iteration is searched again with a wider one
+    bool fail_high = maximizing ? best >= beta && beta < 100000 : best <= alpha && alpha > -100000;
+    bool fail_low = maximizing ? best <= alpha && alpha > -100000 : best >= beta && beta < 100000;
+    if (fail_high || fail_low) return best;
+
+    // The other moves are shared out among all threads, every thread taking the next unsearched
+    // one. The helpers leave their own searches for them
+    std::atomic<int> best_score = best;
+    std::atomic<std::size_t> next_move = 1;
+    std::atomic<std::size_t> fail_high_move = root_moves.size();
+
+    RootMovesJob search_moves = [&](SearchThread& searcher) {
+        Board own_board = board;
+        while (!aborted(searcher)) {
+            std::size_t i = next_move++;
+            if (i >= root_moves.size()) break;
+
+            // The other moves only need an exact score within the margin of the best one, a null
+            // window tells if they get there. The best score only improves, so a bound taken
+            // before another thread raised it is still sound, just less tight. The bound is not
+            // clamped to the aspiration window: a move failing low against alpha would only get
+            // an upper bound, which may still lie within the margin
+            UndoRecord move_undo = own_board.make_move(root_moves[i].move);
+            int score;
+            if (maximizing) {
+                int bound = best_score - margin - 1;
+                score = search(searcher, own_board, depth - 1, bound, bound + 1, 1);
+                if (score > bound && score < beta) {
+                    score = search(searcher, own_board, depth - 1, bound, beta, 1);
+                }
+            } else {
+                int bound = best_score + margin + 1;
+                score = search(searcher, own_board, depth - 1, bound - 1, bound, 1);
+                if (score < bound && score > alpha) {
+                    score = search(searcher, own_board, depth - 1, alpha, bound, 1);
+                }
+            }
+            own_board.unmake_move(move_undo);
+            if (aborted(searcher)) break;
+
+            root_moves[i].score = score;
+            int current = best_score;
+            while ((maximizing ? score > current : score < current) &&
+                   !best_score.compare_exchange_weak(current, score)) {}
+
+            // A move beyond the window ends the iteration, the other threads are cancelled
+            if (maximizing ? score >= beta && beta < 100000 : score <= alpha && alpha > -100000) {
+                std::size_t first_fail = fail_high_move;
+                while (i < first_fail && !fail_high_move.compare_exchange_weak(first_fail, i)) {}
+                for (SearchThread& other : threads) {
+                    other.cancelled = true;
+                }
+            }
+        }
+    };
+
+    if (pool) {
+        std::lock_guard lock(root_mutex);
+        root_job_number++;
+        root_job = &search_moves;
+    }
+    search_moves(thread);
+    if (pool) {
+        {
+            std::lock_guard lock(root_mutex);
+            root_job = nullptr;
+        }
+
+        // Wait for the helpers still searching a root move, taking the tasks of their split points meanwhile
+        while (root_workers > 0) {
+            std::optional<Task> task;
+            if (splitting) task = steal_task(thread, nullptr);
+
+            if (task) {
+                run_task(thread, *task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    for (SearchThread& searched : threads) {
+        searched.cancelled = false;
+    }
+
+    if (stopped) return 0;
+    best = best_score;
+
+    // The move that failed high goes first
+    if (fail_high_move < root_moves.size()) {
+        std::rotate(root_moves.begin(), root_moves.begin() + fail_high_move, root_moves.begin() + fail_high_move + 1);
+        return best;
+    }
+
+    // Stable, so that equally scored moves keep the order of the previous iteration
+    std::stable_sort(root_moves.begin(), root_moves.end(), [maximizing](const RootMove& a, const RootMove& b) {
+        return maximizing ? a.score > b.score : a.score < b.score;
+    });
+
+    transposition_table.store(board.hash(), depth, exact_bound, root_moves[0].score, root_moves[0].move);
+    return best;
+}
+
+std::vector<Move> AlfaBetaPruning::principal_variation(Board board, int depth) const {
+    std::vector<Move> line;
+
+    for (int ply = 0; ply < depth; ply++) {
+        std::optional<TTEntry> entry = transposition_table.probe(board.hash());
+        if (!entry || entry->best_move == NO_MOVE) break;
+
+        // Guard against key collisions, the stored move has to be legal here
+        board.get_possible_actions();
+        if (std::find(board.legal_moves.begin(), board.legal_moves.end(), entry->best_move) == board.legal_moves.end()) break;
+
+        line.push_back(entry->best_move);
+        board.make_move(entry->best_move);
+    }
+
+    return line;
+}
+
+void AlfaBetaPruning::new_search() {
+    transposition_table.new_search();
+}
+
+void AlfaBetaPruning::set_table_size(std::size_t megabytes) {
+    transposition_table.resize(megabytes);
+}
+
+std::uint64_t AlfaBetaPruning::stolen_tasks() const {
+    std::uint64_t stolen = 0;
+    for (const SearchThread& thread : threads) {
+        stolen += thread.stolen;
+    }
+    return stolen;
+}
+
+void AlfaBetaPruning::set_threads(int count) {
+    count = std::max(count, 1);
+    pool.reset();
+    threads = std::vector<SearchThread>(count);
+    if (count > 1) pool = std::make_unique<ThreadPool>(count - 1);
+}
+
+void AlfaBetaPruning::clear_move_ordering(SearchThread& thread) {
+    thread.killers.fill({NO_MOVE, NO_MOVE});
+    for (auto& from : thread.history) {
+        for (auto& to : from) {
+            to.fill(0);
+        }
+    }
+}
+
+void AlfaBetaPruning::update_quiet_statistics(SearchThread& thread, const Board& board, const Move& move, int depth, int ply) {
+    // Most recent killer first, without storing the same move twice
+    KillerMoves& killers = thread.killers[ply];
+    if (killers[0] != move) {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    // Cutoffs close to the root save the most work
+    int& score = thread.history[board.turn][move.from()][move.to()];
+    score += depth * depth;
+    if (score >= HISTORY_LIMIT) {
+        for (auto& from : thread.history[board.turn]) {
+            for (int& to : from) {
+                to /= 2;
+            }
+        }
+    }
+}
+
+void AlfaBetaPruning::count_node(SearchThread& thread) {
+    // Look at the clock only every 1024 nodes, the score of an aborted search is never used
+    if ((++thread.nodes & 1023) == 0 && can_stop && time_manager.hard_expired()) {
+        stopped = true;
+    }
+}
+
+int AlfaBetaPruning::late_move_reduction(int depth, int move_count) {
+    // Grows with the logarithm of both, so that deep searches and long move lists reduce the most
+    static const auto table = [] {
+        std::array<std::array<int, 64>, MAX_SEARCH_DEPTH + 1> reductions{};
+        for (int d = 1; d <= MAX_SEARCH_DEPTH; d++) {
+            for (int m = 1; m < 64; m++) {
+                reductions[d][m] = int(0.5 + std::log(d) * std::log(m) / 2.0);
+            }
+        }
+        return reductions;
+    }();
+    return table[std::min(depth, MAX_SEARCH_DEPTH)][std::min(move_count, 63)];
+}
+
+int AlfaBetaPruning::late_move_reduction(int depth, int move_count, bool quiet, bool in_check, bool gives_check, bool pv_node) {
+    if (depth < LMR_MIN_DEPTH || move_count <= LMR_MIN_MOVES || !quiet || in_check || gives_check) return 0;
+    return std::clamp(late_move_reduction(depth, move_count) - (pv_node ? 1 : 0), 0, depth - 2);
+}
+
+int AlfaBetaPruning::search_later_move(SearchThread& thread, Board& board, int depth, int alpha, int beta, int ply, int reduction) {
+    bool white_moved = board.turn == black;
+
+    auto null_window_search = [&](int new_depth) {
+        return white_moved ? search(thread, board, new_depth, alpha, alpha + 1, ply + 1)
+                           : search(thread, board, new_depth, beta - 1, beta, ply + 1);
+    };
+    auto beats_null_window = [&](int res) {
+        return white_moved ? res > alpha : res < beta;
+    };
+
+    // Principal variation search: the move is only proven worse than the earlier ones with a
+    // null window and searched again if it is not. Late move reductions: a reduced move has to
+    // beat the null window at full depth as well
+    int res = null_window_search(depth - 1 - reduction);
+    if (reduction > 0 && beats_null_window(res)) {
+        res = null_window_search(depth - 1);
+    }
+    if (beats_null_window(res) && (white_moved ? res < beta : res > alpha)) {
+        res = search(thread, board, depth - 1, alpha, beta, ply + 1);
+    }
+    return res;
+}
 
-    if (depth == 0) { // Base case: evaluate and return the board rating at maximum search depth
+void AlfaBetaPruning::split(
+    SearchThread& thread, Board& board, MovePicker& picker, int depth, int ply, int move_count,
+    bool in_check, bool pv_node, int& alpha, int& beta, int& best_score, Move& best_move
+) {
+    SplitPoint split_point;
+    split_point.parent = thread.split;
+    split_point.board = board;
+    split_point.depth = depth;
+    split_point.ply = ply;
+    split_point.in_check = in_check;
+    split_point.pv_node = pv_node;
+    split_point.alpha = alpha;
+    split_point.beta = beta;
+    split_point.best_score = best_score;
+    split_point.best_move = best_move;
+
+    std::vector<Task> tasks;
+    for (Move move = picker.next(); move != NO_MOVE; move = picker.next()) {
+        tasks.push_back({&split_point, move, ++move_count});
+    }
+    if (tasks.empty()) return;
+    split_point.pending = int(tasks.size());
+
+    // The owner takes its tasks from the back in move order, thieves take them from the front
+    {
+        std::lock_guard lock(thread.tasks_mutex);
+        thread.tasks.insert(thread.tasks.end(), tasks.rbegin(), tasks.rend());
+    }
+
+    // The owner works on its own tasks until all of them, stolen ones included, are done. Once
+    // they are all taken it helps the threads working on them with the tasks of their split
+    // points. Other tasks are left alone, so that the owner returns as soon as possible
+    while (split_point.pending > 0) {
+        std::optional<Task> task;
+        {
+            std::lock_guard lock(thread.tasks_mutex);
+            if (!thread.tasks.empty() && thread.tasks.back().split == &split_point) {
+                task = thread.tasks.back();
+                thread.tasks.pop_back();
+            }
+        }
+        if (!task) task = steal_task(thread, &split_point);
+
+        if (task) {
+            run_task(thread, *task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    alpha = split_point.alpha;
+    beta = split_point.beta;
+    best_score = split_point.best_score;
+    best_move = split_point.best_move;
+}
+
+void AlfaBetaPruning::run_task(SearchThread& thread, const Task& task) {
+    SplitPoint& split_point = *task.split;
+    const SplitPoint* previous = thread.split;
+    thread.split = &split_point;
+
+    // Tasks of a split point that cut off meanwhile are only counted as done
+    if (!aborted(thread)) {
+        Board board = split_point.board;
+        bool maximizing = board.turn == white;
+        bool quiet = !MovePicker::is_tactical(board, task.move);
+
+        board.make_move(task.move);
+        bool gives_check = board.is_attacked(lowest_square(board.get_pieces(king, board.turn)), opponent_of(board.turn));
+        int reduction = late_move_reduction(
+            split_point.depth, task.move_count, quiet, split_point.in_check, gives_check, split_point.pv_node
+        );
+
+        // The window of the split point as far as the other brothers have narrowed it
+        int res = search_later_move(
+            thread, board, split_point.depth, split_point.alpha, split_point.beta, split_point.ply, reduction
+        );
+
+        if (!aborted(thread)) {
+            std::lock_guard lock(split_point.mutex);
+            if (maximizing ? res > split_point.best_score : res < split_point.best_score) {
+                split_point.best_score = res;
+                split_point.best_move = task.move;
+            }
+            if (maximizing) {
+                split_point.alpha = std::max(split_point.alpha.load(), res);
+            } else {
+                split_point.beta = std::min(split_point.beta.load(), res);
+            }
+
+            // A cutoff cancels the brothers still being searched
+            if (split_point.beta <= split_point.alpha && !split_point.cutoff) {
+                split_point.cutoff = true;
+                if (quiet) {
+                    update_quiet_statistics(thread, split_point.board, task.move, split_point.depth, split_point.ply);
+                }
+            }
+        }
+    }
+
+    thread.split = previous;
+    split_point.pending--;
+}
+
+std::optional<AlfaBetaPruning::Task> AlfaBetaPruning::steal_task(SearchThread& thread, const SplitPoint* below) {
+    std::size_t index = &thread - threads.data();
+
+    auto wanted = [below](const Task& task) {
+        if (!below) return true;
+        for (const SplitPoint* split = task.split; split; split = split->parent) {
+            if (split == below) return true;
+        }
+        return false;
+    };
+
+    // Look through the other threads, starting with the next one, for the oldest wanted task
+    for (std::size_t i = 1; i < threads.size(); i++) {
+        SearchThread& victim = threads[(index + i) % threads.size()];
+        std::lock_guard lock(victim.tasks_mutex);
+        auto task = std::find_if(victim.tasks.begin(), victim.tasks.end(), wanted);
+        if (task != victim.tasks.end()) {
+            Task stolen = *task;
+            victim.tasks.erase(task);
+            thread.stolen++;
+            return stolen;
+        }
+    }
+    return std::nullopt;
+}
+
+void AlfaBetaPruning::steal_tasks(SearchThread& thread) {
+    while (!search_done) {
+        std::optional<Task> task = steal_task(thread, nullptr);
+        if (task) {
+            run_task(thread, *task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool AlfaBetaPruning::null_move_allowed(const Board& board) {
+    Bitboard pawns_and_king = board.get_pieces(pawn, board.turn) | board.get_pieces(king, board.turn);
+    return !board.checkers && (board.occupancy[board.turn] & ~pawns_and_king);
+}
+
+int AlfaBetaPruning::search(SearchThread& thread, Board& board, int depth, int alpha, int beta, int ply, bool null_move) {
+    // The leaves are resolved by the quiescence search
+    if (depth == 0) return quiescence(thread, board, alpha, beta);
+
+    count_node(thread);
+    if (aborted(thread)) return 0;
+
+    Move table_move = NO_MOVE;
+
+    // Reuse the result of an earlier search of this position if it was deep enough
+    if (std::optional<TTEntry> entry = transposition_table.probe(board.hash())) {
+        if (entry->depth >= depth &&
+            (entry->bound() == exact_bound ||
+             (entry->bound() == lower_bound && entry->score >= beta) ||
+             (entry->bound() == upper_bound && entry->score <= alpha))
+        ) {
+            return entry->score;
+        }
+        table_move = entry->best_move;
+    }
+
+    board.update_analysis();
+
+    bool pv_node = beta - alpha > 1;
+    bool maximizing = board.turn == white;
+    bool in_check = board.checkers;
+
+    // The static rating decides the pruning below, which is only done outside of the principal
+    // variation, out of check and away from mate scores
+    bool prunable = !pv_node && !in_check && std::abs(alpha) < 100000 && std::abs(beta) < 100000;
+    int static_rating = 0;
+    if (prunable) {
         board.get_rating();
-        return board.final_rating;
-    } else if (board.active_pieces.empty()) {  // No active pieces means checkmate or stalemate
-        if (!board.checkin_pieces.empty()) {  // Checkmate situation
+        static_rating = board.final_rating;
+    }
+
+    // Reverse futility pruning: a rating this far beyond the window is not expected to be lost
+    // again in the few plies left
+    if (prunable && depth <= REVERSE_FUTILITY_MAX_DEPTH) {
+        int margin = REVERSE_FUTILITY_MARGIN * depth;
+        if (maximizing ? static_rating - margin >= beta : static_rating + margin <= alpha) {
+            return maximizing ? static_rating - margin : static_rating + margin;
+        }
+    }
+
+    // Razoring: this far behind the window only a capture can help, the quiescence search decides
+    if (prunable && depth <= RAZOR_MAX_DEPTH) {
+        int margin = RAZOR_MARGIN * depth;
+        if (maximizing ? static_rating + margin <= alpha : static_rating - margin >= beta) {
+            int res = quiescence(thread, board, alpha, beta);
+            if (aborted(thread)) return 0;
+            if (maximizing ? res <= alpha : res >= beta) return res;
+
+            // The quiescence search left the analysis of a capture on the board
+            board.update_analysis();
+        }
+    }
+
+    // Null move pruning: if the opponent cannot reach the window even when the player to move
+    // passes, a real move would be even better
+    if (prunable && null_move && depth >= NULL_MOVE_MIN_DEPTH && null_move_allowed(board) &&
+        (maximizing ? static_rating >= beta : static_rating <= alpha)
+    ) {
+        int reduction = NULL_MOVE_REDUCTION + (depth > 6 ? 1 : 0);
+
+        UndoRecord undo = board.make_null_move();
+        int res = maximizing
+            ? search(thread, board, depth - 1 - reduction, beta - 1, beta, ply + 1, false)
+            : search(thread, board, depth - 1 - reduction, alpha, alpha + 1, ply + 1, false);
+        board.unmake_null_move(undo);
+
+        if (aborted(thread)) return 0;
+
+        // Mate scores of a null move search are not proven, only the bound is kept
+        if (maximizing ? res >= beta : res <= alpha) {
+            res = maximizing ? std::min(res, 100000) : std::max(res, -100000);
+            transposition_table.store(board.hash(), depth, maximizing ? lower_bound : upper_bound, res, table_move);
+            return res;
+        }
+
+        // The null move search left the analysis of its own position on the board
+        board.update_analysis();
+    }
+
+    // Futility pruning: near the leaves a quiet move is not expected to lift a rating this far
+    // behind the window into it, such moves are skipped after the first move
+    int futility_rating = maximizing ? static_rating + FUTILITY_MARGIN * depth : static_rating - FUTILITY_MARGIN * depth;
+    bool futile = prunable && depth <= FUTILITY_MAX_DEPTH &&
+                  (maximizing ? futility_rating <= alpha : futility_rating >= beta);
+
+    // The moves are generated in stages by the picker, a cutoff spares the later stages
+    MovePicker picker(board, table_move, thread.killers[ply], thread.history);
+
+    int original_alpha = alpha;
+    int original_beta = beta;
+    int curr_min_max = (board.turn == white) ? -100000 : 100000; // Initialize best score
+    Move best_move = NO_MOVE;
+
+    int move_count = 0;
+
+    for (Move move = picker.next(); move != NO_MOVE; move = picker.next()) {
+        bool first = best_move == NO_MOVE;
+        if (first) best_move = move;
+        move_count++;
+        bool quiet = !MovePicker::is_tactical(board, move);
+
+        // Captures losing material by static exchange evaluation are pruned near the leaves
+        if (prunable && !first && !quiet && depth <= SEE_PRUNING_MAX_DEPTH &&
+            board.see(move) < -SEE_PRUNING_MARGIN * depth
+        ) {
+            continue;
+        }
+
+        // Apply the move, evaluate the resulting board recursively and take the move back.
+        // Principal variation search: the first move is expected to be the best, the others
+        // are only proven worse with a null window and searched again if they are not
+        UndoRecord undo = board.make_move(move);
+        bool gives_check = board.is_attacked(lowest_square(board.get_pieces(king, board.turn)), opponent_of(board.turn));
+
+        if (futile && !first && quiet && !gives_check) {
+            board.unmake_move(undo);
+
+            // The skipped move is assumed to score no better than the futility rating
+            curr_min_max = maximizing ? std::max(curr_min_max, futility_rating) : std::min(curr_min_max, futility_rating);
+            continue;
+        }
+
+        int res;
+        if (first) {
+            res = search(thread, board, depth - 1, alpha, beta, ply + 1);
+        } else {
+            int reduction = late_move_reduction(depth, move_count, quiet, in_check, gives_check, pv_node);
+            res = search_later_move(thread, board, depth, alpha, beta, ply, reduction);
+        }
+        board.unmake_move(undo);
+
+        // Nothing of an aborted search may reach the table
+        if (aborted(thread)) return 0;
+
+        if (board.turn == white) {
+            if (res > curr_min_max) {
+                curr_min_max = res;
+                best_move = move;
+            }
+            alpha = std::max(alpha, res);
+        } else {
+            if (res < curr_min_max) {
+                curr_min_max = res;
+                best_move = move;
+            }
+            beta = std::min(beta, res);
+        }
+
+        // Alpha-beta pruning: cut off search if no better outcome can be found
+        if (beta <= alpha) {
+            if (!MovePicker::is_tactical(board, move)) {
+                update_quiet_statistics(thread, board, move, depth, ply);
+            }
+            break;
+        }
+
+        // Young Brothers Wait: once the eldest brother did not cut off, the other moves are
+        // searched in parallel. The split depth is above the depths of the move pruning
+        if (first && splitting && depth >= SPLIT_MIN_DEPTH) {
+            split(thread, board, picker, depth, ply, move_count, in_check, pv_node, alpha, beta, curr_min_max, best_move);
+            if (aborted(thread)) return 0;
+            break;
+        }
+    }
+
+    if (best_move == NO_MOVE) {  // No legal moves means checkmate or stalemate
+        if (board.checkers) {  // Checkmate situation
             if (board.turn == white) {
                 return -100000 - depth * 50; // Losing score adjusted by depth for quicker mate
             } else {
@@ -16,62 +735,83 @@ int AlfaBetaPruning::operator()(Board board, int depth, int alpha, int beta) {
         } else { // Stalemate or draw
             return 0;
         }
+    }
+
+    // Scores outside the original window are only bounds of the true score
+    Bound bound = (curr_min_max <= original_alpha) ? upper_bound :
+                  (curr_min_max >= original_beta) ? lower_bound :
+                  exact_bound;
+    transposition_table.store(board.hash(), depth, bound, curr_min_max, best_move);
+
+    // Return the best score found
+    return curr_min_max;
+}
+
+int AlfaBetaPruning::quiescence(SearchThread& thread, Board& board, int alpha, int beta) {
+    count_node(thread);
+    if (aborted(thread)) return 0;
+
+    board.get_possible_captures();
+    bool maximizing = board.turn == white;
+
+    int curr_min_max;
+    if (board.checkers) {
+        // In check every evasion is searched, without any evasion it is checkmate
+        curr_min_max = maximizing ? -100000 : 100000;
+        if (board.legal_moves.empty()) return curr_min_max;
     } else {
-        int res;
-        int curr_min_max = (board.turn == white) ? -100000 : 100000; // Initialize best score
-
-        // Iterate over all active pieces and their possible moves
-        for (const auto& position : board.active_pieces) {
-            for (const auto& move : board.board[position[0]][position[1]]->possible_actions) {
-                // Lambda to apply move and recursively evaluate resulting board
-                auto make_and_minimax = [&](char promotion) {
-                    return (*this)(board.make_action_board(
-                        position[0],
-                        position[1],
-                        move[0],
-                        move[1],
-                        promotion), depth - 1, alpha, beta);
-                };
-
-                if (board.turn == white) {
-                    if (board.board[position[0]][position[1]]->possible_actions.promotion) {
-                        // Evaluate all promotion options for white
-                        res = std::max({
-                            make_and_minimax('Q'),
-                            make_and_minimax('N'),
-                            make_and_minimax('B'),
-                            make_and_minimax('R'),
-                        });
-                    } else {
-                        res = make_and_minimax(' ');
-                    }
-                    curr_min_max = std::max(curr_min_max, res);
-                    alpha = std::max(alpha, res);
-
-                } else {
-                    if (board.board[position[0]][position[1]]->possible_actions.promotion) {
-                        // Evaluate all promotion options for black
-                        res = std::min({
-                            make_and_minimax('q'),
-                            make_and_minimax('n'),
-                            make_and_minimax('b'),
-                            make_and_minimax('r')
-                        });
-                    } else {
-                        res = make_and_minimax(' ');
-                    }
-                    curr_min_max = std::min(curr_min_max, res);
-                    beta = std::min(beta, res);
+        // Stand pat: the player to move does not have to capture, the rating is a bound of the score
+        board.get_rating();
+        curr_min_max = board.final_rating;
 
-                }
+        if (maximizing) {
+            if (curr_min_max >= beta) return curr_min_max;
+            alpha = std::max(alpha, curr_min_max);
+        } else {
+            if (curr_min_max <= alpha) return curr_min_max;
+            beta = std::min(beta, curr_min_max);
+        }
+    }
+
+    int stand_pat = curr_min_max;
+    bool in_check = board.checkers;
 
-                // Alpha-beta pruning: cut off search if no better outcome can be found
-                if (beta <= alpha) {
-                    return curr_min_max;
+    // Captures by MVV-LVA, the picker keeps its own copy of the moves
+    MovePicker picker(board);
+
+    for (Move move = picker.next(); move != NO_MOVE; move = picker.next()) {
+        if (!in_check) {
+            // Delta pruning: skip captures that cannot reach the window even with a margin
+            if (move.flag() != promotion_move) {
+                Piece captured = board.board[move.to()];
+                int gain = Board::material_rating_weight * (captured ? captured.get_value() : 1) + DELTA_MARGIN;
+                if (maximizing ? stand_pat + gain <= alpha : stand_pat - gain >= beta) {
+                    continue;
                 }
             }
+
+            // Captures losing material by static exchange evaluation cannot improve on standing pat
+            if (board.see(move) < 0) continue;
+        }
+
+        UndoRecord undo = board.make_move(move);
+        int res = quiescence(thread, board, alpha, beta);
+        board.unmake_move(undo);
+
+        if (aborted(thread)) return 0;
+
+        if (maximizing) {
+            curr_min_max = std::max(curr_min_max, res);
+            alpha = std::max(alpha, res);
+        } else {
+            curr_min_max = std::min(curr_min_max, res);
+            beta = std::min(beta, res);
+        }
+
+        if (beta <= alpha) {
+            break;
         }
-        // Return the best score found
-        return curr_min_max;
     }
-}
\ No newline at end of file
+
+    return curr_min_max;
+}
@@ -0,0 +1,170 @@
+#include "Bitboard.h"
+
+namespace {
+    // Build the attack table of a piece that moves by fixed steps
+    constexpr std::array<Bitboard, 64> step_attacks(const std::array<std::array<int, 2>, 8>& directions, int count) {
+        std::array<Bitboard, 64> table{};
+
+        for (int sq = 0; sq < 64; sq++) {
+            auto [row, col] = position(sq);
+            for (int i = 0; i < count; i++) {
+                int new_row = row + directions[i][0];
+                int new_col = col + directions[i][1];
+
+                if (new_row >= 0 && new_row < 8 && new_col >= 0 && new_col < 8) {
+                    table[sq] |= square_bb(square(new_row, new_col));
+                }
+            }
+        }
+        return table;
+    }
+
+    // Walk every direction until the edge of the board or the first occupied square (included)
+    Bitboard ray_attacks(int sq, Bitboard occupied, const std::array<std::array<int, 2>, 4>& directions) {
+        Bitboard attacks = 0;
+        auto [row, col] = position(sq);
+
+        for (auto direction : directions) {
+            int new_row = row + direction[0];
+            int new_col = col + direction[1];
+
+            while (new_row >= 0 && new_row < 8 && new_col >= 0 && new_col < 8) {
+                Bitboard target = square_bb(square(new_row, new_col));
+                attacks |= target;
+
+                if (occupied & target) break;
+
+                new_row += direction[0];
+                new_col += direction[1];
+            }
+        }
+        return attacks;
+    }
+
+    constexpr std::array<std::array<int, 2>, 4> ROOK_DIRECTIONS = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+    constexpr std::array<std::array<int, 2>, 4> BISHOP_DIRECTIONS = {{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+    // Shared storage of every square's attack sets (4096 and 512 slots at most per square)
+    std::array<Bitboard, 102400> rook_table;
+    std::array<Bitboard, 5248> bishop_table;
+
+    // Small xorshift generator, seeded so the magics found are the same on every run
+    class MagicRandom {
+    public:
+        explicit MagicRandom(std::uint64_t seed): state(seed) {}
+
+        // Candidates with few set bits make good magics
+        Bitboard sparse() {
+            return next() & next() & next();
+        }
+
+    private:
+        std::uint64_t state;
+
+        std::uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+    };
+
+    // Find a magic for every square and fill its slice of the attack table
+    void init_magics(
+        std::array<Magic, 64>& magics,
+        Bitboard* table,
+        const std::array<std::array<int, 2>, 4>& directions
+    ) {
+        MagicRandom random(728);
+        std::array<Bitboard, 4096> occupancies;
+        std::array<Bitboard, 4096> references;
+        std::array<int, 4096> epoch{};
+        int attempt = 0;
+
+        for (int sq = 0; sq < 64; sq++) {
+            auto [row, col] = position(sq);
+
+            // The last square of a ray never blocks anything behind it
+            Bitboard edges = ((ROW_0 | ROW_7) & ~(ROW_0 << (8 * row))) |
+                             ((COLUMN_0 | COLUMN_7) & ~(COLUMN_0 << col));
+
+            Magic& entry = magics[sq];
+            entry.mask = ray_attacks(sq, 0, directions) & ~edges;
+            entry.shift = 64 - count_squares(entry.mask);
+            entry.attacks = table;
+
+            // Enumerate every subset of the mask (Carry-Rippler trick)
+            int size = 0;
+            Bitboard subset = 0;
+            do {
+                occupancies[size] = subset;
+                references[size] = ray_attacks(sq, subset, directions);
+                size++;
+                subset = (subset - entry.mask) & entry.mask;
+            } while (subset);
+
+            // Try candidates until all subsets map to slots without a destructive collision
+            for (int i = 0; i < size;) {
+                do {
+                    entry.magic = random.sparse();
+                } while (count_squares((entry.magic * entry.mask) >> 56) < 6);
+
+                attempt++;
+                for (i = 0; i < size; i++) {
+                    unsigned index = entry.index(occupancies[i]);
+
+                    if (epoch[index] < attempt) {
+                        epoch[index] = attempt;
+                        table[index] = references[i];
+                    } else if (table[index] != references[i]) {
+                        break;
+                    }
+                }
+            }
+            table += size;
+        }
+    }
+
+    // Build the magic and line tables before any board is created
+    struct TablesInitializer {
+        TablesInitializer() {
+            init_magics(ROOK_MAGICS, rook_table.data(), ROOK_DIRECTIONS);
+            init_magics(BISHOP_MAGICS, bishop_table.data(), BISHOP_DIRECTIONS);
+
+            for (int from = 0; from < 64; from++) {
+                for (int to = 0; to < 64; to++) {
+                    if (from == to) continue;
+
+                    Bitboard to_bb = square_bb(to);
+                    for (auto attacks : {rook_attacks, bishop_attacks}) {
+                        if (attacks(from, 0) & to_bb) {
+                            LINE[from][to] = (attacks(from, 0) & attacks(to, 0)) | square_bb(from) | to_bb;
+                            BETWEEN[from][to] = attacks(from, to_bb) & attacks(to, square_bb(from));
+                        }
+                    }
+                }
+            }
+        }
+    };
+}
+
+std::array<Magic, 64> ROOK_MAGICS;
+std::array<Magic, 64> BISHOP_MAGICS;
+std::array<std::array<Bitboard, 64>, 64> BETWEEN;
+std::array<std::array<Bitboard, 64>, 64> LINE;
+
+const std::array<Bitboard, 64> KNIGHT_ATTACKS = step_attacks(
+    {{{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}}}, 8
+);
+
+const std::array<Bitboard, 64> KING_ATTACKS = step_attacks(
+    {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}}, 8
+);
+
+const std::array<std::array<Bitboard, 64>, 2> PAWN_ATTACKS = {
+    step_attacks({{{1, 1}, {1, -1}}}, 2), // White pawns attack towards higher rows
+    step_attacks({{{-1, 1}, {-1, -1}}}, 2) // Black pawns attack towards lower rows
+};
+
+// Defined after the tables so they are already zero-initialized when it runs
+static const TablesInitializer tables_initializer;
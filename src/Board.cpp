@@ -2,14 +2,15 @@
 #include "Piece.h"
 #include "Types.h"
 #include "Game.h"
+#include "Zobrist.h"
 
 // Default constructor initializes the board to the standard starting position
 Board::Board()
     : turn(white),
-      castling("KQkq"),
+      castling(white_kingside | white_queenside | black_kingside | black_queenside),
       enpassant({8, 8}),
-      board(create_board()),
       winner(notFinished) {
+    create_board();
     get_possible_actions();
 }
 
@@ -19,10 +20,10 @@ Board::Board(
     const std::string& input_castling,
     const std::array<std::array<char, 8>, 8>& simplify_board)
     : turn(input_turn),
-      castling(input_castling),
+      castling(parse_castling(input_castling)),
       enpassant({8, 8}),
-      board(create_board(simplify_board)),
       winner(notFinished) {
+    create_board(simplify_board);
     get_possible_actions();
 }
 
@@ -33,91 +34,95 @@ Board::Board(
     const std::array<int, 2>& input_enpassant,
     const std::array<std::array<char, 8>, 8>& simplify_board)
     : turn(input_turn),
-      castling(input_castling),
+      castling(parse_castling(input_castling)),
       enpassant(input_enpassant),
-      board(create_board(simplify_board)),
       winner(notFinished) {
+    create_board(simplify_board);
     get_possible_actions();
 }
 
-// Copy constructor
-Board::Board(const Board& other_board) {
-    turn = other_board.turn;
-    castling = other_board.castling;
-    enpassant = other_board.enpassant;
-    winner = other_board.winner;
+// Create a board from a position in Forsyth-Edwards Notation
+std::expected<Board, std::string> Board::from_fen(const std::string& fen) {
+    std::istringstream fields(fen);
+    std::string placement, side, castling_field, enpassant_field;
 
-    for (int row = 0; row < ROWS; row++) {
-        for (int col = 0; col < COLS; col++) {
-            if (other_board.board[row][col]) {
-                board[row][col] = create_piece(other_board.board[row][col]->symbol, row, col);
-            }
-        }
+    if (!(fields >> placement >> side)) {
+        return std::unexpected("FEN needs at least the piece placement and the side to move.");
     }
-}
+    fields >> castling_field >> enpassant_field; // Optional, the move counters are ignored
 
-// Assignment operator
-Board& Board::operator=(const Board& other_board) {
-    if (this == &other_board) return *this;
+    // Ranks are listed from the 8th to the 1st, files from a to h (column 7 to 0)
+    std::array<std::array<char, 8>, 8> simplify_board;
+    for (auto& current_row : simplify_board) {
+        current_row.fill(' ');
+    }
 
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            board[row][col].reset();
+    int row = 7;
+    int col = 7;
+    for (char symbol : placement) {
+        if (symbol == '/') {
+            if (col != -1 || row == 0) return std::unexpected("Invalid rank in FEN: " + placement);
+            row--;
+            col = 7;
+        } else if (symbol >= '1' && symbol <= '8') {
+            col -= symbol - '0';
+            if (col < -1) return std::unexpected("Invalid rank in FEN: " + placement);
+        } else if (Piece::get_piece(symbol) && col >= 0) {
+            simplify_board[row][col--] = symbol;
+        } else {
+            return std::unexpected("Invalid piece placement in FEN: " + placement);
         }
     }
+    if (row != 0 || col != -1) return std::unexpected("Invalid piece placement in FEN: " + placement);
 
-    turn = other_board.turn;
-    castling = other_board.castling;
-    enpassant = other_board.enpassant;
-    winner = other_board.winner;
+    if (side != "w" && side != "b") return std::unexpected("Invalid side to move in FEN: " + side);
 
-    for (int row = 0; row < ROWS; row++) {
-        for (int col = 0; col < COLS; col++) {
-            if (other_board.board[row][col]) {
-                board[row][col] = create_piece(other_board.board[row][col]->symbol, row, col);
-            } else {
-                board[row][col] = nullptr;
-            }
+    std::string castling_rights = "____";
+    if (!castling_field.empty() && castling_field != "-") {
+        for (char right : castling_field) {
+            std::size_t index = std::string("KQkq").find(right);
+            if (index == std::string::npos) return std::unexpected("Invalid castling rights in FEN: " + castling_field);
+            castling_rights[index] = right;
         }
     }
-    get_possible_actions();
 
-    return *this;
+    std::array<int, 2> enpassant_square = {8, 8};
+    if (!enpassant_field.empty() && enpassant_field != "-") {
+        if (enpassant_field.size() != 2 ||
+            enpassant_field[0] < 'a' || enpassant_field[0] > 'h' ||
+            (enpassant_field[1] != '3' && enpassant_field[1] != '6')
+        ) {
+            return std::unexpected("Invalid en passant square in FEN: " + enpassant_field);
+        }
+        enpassant_square = {enpassant_field[1] - '1', 'h' - enpassant_field[0]};
+    }
+
+    return Board(side == "w" ? white : black, castling_rights, enpassant_square, simplify_board);
 }
 
 // Reset the board to its initial state
 void Board::reset() {
     turn = white;
-    castling = "KQkq";
+    castling = white_kingside | white_queenside | black_kingside | black_queenside;
     enpassant = {8, 8};
-    board = create_board();
+    create_board();
     winner = notFinished;
     get_possible_actions();
 }
 
 // Compare two boards for equality
 bool Board::operator==(const Board& other) const {
+    if (this->zobrist_key != other.zobrist_key) return false;
     if (this->turn != other.turn) return false;
     if (this->castling != other.castling) return false;
     if (this->enpassant != other.enpassant) return false;
-    if (this->attacked_positions != other.attacked_positions) return false;
-    if (this->checkin_pieces != other.checkin_pieces) return false;
-    if (this->pinned_pieces != other.pinned_pieces) return false;
-    if (this->active_pieces != other.active_pieces) return false;
-    
-    // Compare individual pieces on the board
-    for (int i = 0; i < this->ROWS; i++) {
-        for (int j = 0; j < this->COLS; j++) {
-            // Check if either position is non-empty
-            if (this->board[i][j] || other.board[i][j]) {
-                // Check if mismatch is found
-                if (*(this->board[i][j]) != *(other.board[i][j])) {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
+    if (this->attacked != other.attacked) return false;
+    if (this->checkers != other.checkers) return false;
+    if (this->pinned != other.pinned) return false;
+    if (this->legal_moves != other.legal_moves) return false;
+
+    // Compare the pieces on the board
+    return this->pieces == other.pieces;
 }
 
 bool Board::operator!=(const Board& other) const {
@@ -127,32 +132,27 @@ bool Board::operator!=(const Board& other) const {
 // Output the current state of the board
 std::ostream& operator<<(std::ostream& out, const Board& board_class) {
     out << "Turn: " << board_class.turn << ", ";
-    out << "Castling: " << board_class.castling << ", ";
+    out << "Castling: " << board_class.castling_string() << ", ";
     out << "State: " << std::endl;
 
     for (int row = 0; row < board_class.ROWS; row++) {
         // Print row numbers
         out << row + 1 << " ";
         for (int col = 0; col < board_class.COLS; col++) {
-            if (board_class.board[row][col]) {
-                // Display piece symbol
-                out << "[" << board_class.board[row][col]->symbol << "]";
-            } else {
-                // Empty square
-                out << "[ ]";
-            }
+            // Display piece symbol, or a blank for an empty square
+            out << "[" << board_class.get_symbol(row, col) << "]";
         }
         out << std::endl;
     }
     // Column labels
     out << "   h  g  f  e  d  c  b  a " << std::endl;
-    
+
     return out;
 };
 
 // Create a board with the standard initial position
-std::array<std::array<std::unique_ptr<Piece>, 8>, 8> Board::create_board() const {
-    std::array<std::array<char, 8>, 8> simplify_board = {{
+void Board::create_board() {
+    create_board({{
         {'R', 'N', 'B', 'K', 'Q', 'B', 'N', 'R'},
         {'P', 'P', 'P', 'P', 'P', 'P', 'P', 'P'},
         {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
@@ -161,71 +161,90 @@ std::array<std::array<std::unique_ptr<Piece>, 8>, 8> Board::create_board() const
         {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
         {'p', 'p', 'p', 'p', 'p', 'p', 'p', 'p'},
         {'r', 'n', 'b', 'k', 'q', 'b', 'n', 'r'}
-    }};
+    }});
+}
 
-    std::array<std::array<std::unique_ptr<Piece>, 8>, 8> board;
+// Create a board from a custom configuration
+void Board::create_board(
+    const std::array<std::array<char, 8>, 8>& simplify_board
+) {
+    pieces = {};
+    occupancy = {};
+    occupied = 0;
+    board = {};
+    zobrist_key = 0;
 
     // Populate the board with pieces
     for (int row = 0; row < ROWS; row++) {
         for (int col = 0; col < COLS; col++) {
             if (simplify_board[row][col] != ' ') {
-                board[row][col] = create_piece(simplify_board[row][col], row, col);
+                put_piece(Piece::get_piece(simplify_board[row][col]), square(row, col));
             }
         }
     }
 
-    return board;
+    // Start the position key from the side to move, castling rights and en passant square
+    zobrist_key ^= (turn == black ? Zobrist::BLACK_TO_MOVE : 0) ^
+                   Zobrist::castling_key(castling) ^
+                   Zobrist::enpassant_key(enpassant);
 }
 
-// Create a board from a custom configuration
-std::array<std::array<std::unique_ptr<Piece>, 8>, 8> Board::create_board(
-    const std::array<std::array<char, 8>, 8>& simplify_board
-) const {
-    std::array<std::array<std::unique_ptr<Piece>, 8>, 8> board;
-
-    // Populate the board with pieces
-    for (int row = 0; row < ROWS; row++) {
-        for (int col = 0; col < COLS; col++) {
-            if (simplify_board[row][col] != ' ') {
-                board[row][col] = create_piece(simplify_board[row][col], row, col);
-            }
-        }
+// Castling rights as text, "KQkq" with '_' for every right that is gone
+std::string Board::castling_string() const {
+    std::string text = "KQkq";
+    for (int i = 0; i < 4; i++) {
+        if (!(castling & (1 << i))) text[i] = '_';
     }
+    return text;
+}
 
-    return board;
+// Symbol of the piece on the given square (' ' if the square is empty)
+char Board::get_symbol(int row, int col) const {
+    return board[square(row, col)].symbol();
 }
 
-// Calculate possible moves for the current player
-void Board::get_possible_actions() {
-    attacked_positions = {};
-    checkin_pieces = {};
-    pinned_pieces = {};
-    active_pieces = {};
+// Possible actions of the piece on the given square, built from the legal moves
+Actions Board::get_actions(int row, int col) const {
+    Actions actions;
+    int from = square(row, col);
+    Piece piece = board[from];
+    if (!piece) return actions;
 
-    // Check moves for the opponent's pieces
-    for (auto &current_row : board) {
-        for (auto &current_piece : current_row) {
-            if (current_piece && current_piece->player != turn) {
-                current_piece->possible_actions.reset();
-                current_piece->check_piece_possible_moves_opponent(*this);
+    if (piece.player() == turn) {
+        for (const Move& move : legal_moves) {
+            if (move.from() != from) continue;
+
+            std::array<int, 2> target = position(move.to());
+            if (board[move.to()] || move.flag() == enpassant_move) {
+                actions.attacks.insert(target);
+            } else {
+                actions.moves.insert(target);
             }
+            if (move.flag() == promotion_move) {
+                actions.promotion = true;
+            }
+        }
+    } else if (piece.piece() == pawn) {
+        // Pawns of the waiting player show the pieces they threaten and a pending promotion
+        Bitboard attacks = PAWN_ATTACKS[piece.player()][from] & occupancy[turn];
+        while (attacks) {
+            actions.attacks.insert(position(pop_square(attacks)));
         }
+        actions.promotion = (piece.player() == white) ? row == 6 : row == 1;
     }
+    return actions;
+}
 
-    PositionSet checking_positions = flatting_checkin_pieces(checkin_pieces);
+// Calculate possible moves for the current player
+void Board::get_possible_actions() {
+    legal_moves.clear();
+    update_analysis();
 
     // Check moves for the current player's pieces
-    for (auto &current_row : board) {
-        for (auto &current_piece : current_row) {
-            if (current_piece && current_piece->player == turn) {
-                current_piece->possible_actions.reset();
-                current_piece->check_piece_possible_moves_active_player(*this, checking_positions);
-            }
-        }
-    }
+    add_legal_moves(all_moves);
 
-    if (!active_pieces.size()) {
-        if (checkin_pieces.size()) {
+    if (legal_moves.empty()) {
+        if (checkers) {
             winner = (turn == white) ? blackWin : whiteWin;
         } else {
             winner = draw;
@@ -233,6 +252,88 @@ void Board::get_possible_actions() {
     }
 }
 
+// Calculate the captures and queen promotions of the current player (every move when in check)
+void Board::get_possible_captures() {
+    legal_moves.clear();
+    update_analysis();
+
+    // All evasions are needed to tell a checkmate from a quiet position
+    add_legal_moves(checkers ? all_moves : captures);
+}
+
+// Checks, pins and the squares attacked by the opponent
+void Board::update_analysis() {
+    update_checks_and_pins();
+
+    // Squares attacked by the opponent, with the king removed so that it cannot step back along a checking line
+    attacked = attacks_by((turn == white) ? black : white, occupied & ~get_pieces(king, turn));
+}
+
+// Add the legal moves of the given type, the only branch on the side to move
+void Board::add_legal_moves(GenerationType type) {
+    if (turn == white) {
+        switch (type) {
+            case all_moves: generate_moves<white, all_moves>(); break;
+            case captures:  generate_moves<white, captures>(); break;
+            case quiets:    generate_moves<white, quiets>(); break;
+        }
+    } else {
+        switch (type) {
+            case all_moves: generate_moves<black, all_moves>(); break;
+            case captures:  generate_moves<black, captures>(); break;
+            case quiets:    generate_moves<black, quiets>(); break;
+        }
+    }
+}
+
+// Check if the move is legal by generating the moves of its piece only
+bool Board::is_legal(const Move& move) {
+    Piece piece = board[move.from()];
+    if (!piece || piece.player() != turn) return false;
+
+    // The moves of the piece are added after the legal moves and dropped again
+    int count = legal_moves.size();
+    if (turn == white) {
+        piece.check_piece_possible_moves_active_player<white, all_moves>(*this, move.from());
+    } else {
+        piece.check_piece_possible_moves_active_player<black, all_moves>(*this, move.from());
+    }
+
+    bool legal = std::find(legal_moves.begin() + count, legal_moves.end(), move) != legal_moves.end();
+    legal_moves.resize(count);
+    return legal;
+}
+
+// Add the legal moves of every piece of the player to move, visiting only the occupied squares
+template<PlayerColor Us, GenerationType Type>
+void Board::generate_moves() {
+    Bitboard own_pieces = occupancy[Us];
+    while (own_pieces) {
+        int sq = pop_square(own_pieces);
+        board[sq].check_piece_possible_moves_active_player<Us, Type>(*this, sq);
+    }
+}
+
+// Rate the pieces of the opponent, then the pieces of the player to move
+template<PlayerColor Us>
+void Board::rate_pieces() {
+    constexpr PlayerColor opponent = opponent_of(Us);
+
+    // Check moves for the opponent's pieces
+    Bitboard opponent_pieces = occupancy[opponent];
+    while (opponent_pieces) {
+        int sq = pop_square(opponent_pieces);
+        board[sq].update_rating_opponent<opponent>(*this, sq);
+    }
+
+    // Check moves for the current player's pieces
+    Bitboard own_pieces = occupancy[Us];
+    while (own_pieces) {
+        int sq = pop_square(own_pieces);
+        board[sq].update_rating_active_player<Us>(*this, sq);
+    }
+}
+
 // Calculate the rating of the board
 void Board::get_rating() {
     white_material_rating = 0;
@@ -240,40 +341,18 @@ void Board::get_rating() {
     white_attack_rating = 0;
     black_attack_rating = 0;
 
-    // Check moves for the opponent's pieces
-    for (auto &current_row : board) {
-        for (auto &current_piece : current_row) {
-            if (current_piece && current_piece->player != turn) {
-                current_piece->update_rating_opponent(*this);
-
-                if (current_piece->piece != king) {
-                    if (current_piece->player == white) {
-                        white_material_rating += material_rating_weight * current_piece->get_value();
-                    } else {
-                        black_material_rating -= material_rating_weight * current_piece->get_value();
-                    }
-                }
-            }
-        }
+    // Material of both players, counted from the piece sets (the king is not counted)
+    for (PieceType type : {pawn, rook, knight, bishop, queen}) {
+        int value = material_rating_weight * Piece(type, white).get_value();
+        white_material_rating += value * count_squares(get_pieces(type, white));
+        black_material_rating -= value * count_squares(get_pieces(type, black));
     }
 
-    PositionSet checking_positions = flatting_checkin_pieces(checkin_pieces);
-
-    // Check moves for the current player's pieces
-    for (auto &current_row : board) {
-        for (auto &current_piece : current_row) {
-            if (current_piece && current_piece->player == turn) {
-                current_piece->update_rating_active_player(*this, checking_positions);
-                
-                if (current_piece->piece != king) {
-                    if (current_piece->player == white) {
-                        white_material_rating += material_rating_weight * current_piece->get_value();
-                    } else {
-                        black_material_rating -= material_rating_weight * current_piece->get_value();
-                    }
-                }
-            }
-        }
+    // Rate the pieces of both players, the only branch on the side to move
+    if (turn == white) {
+        rate_pieces<white>();
+    } else {
+        rate_pieces<black>();
     }
 
     final_rating = white_material_rating + white_attack_rating + black_material_rating + black_attack_rating;
@@ -307,9 +386,9 @@ void Board::print_white_perspective(
         std::cout << row + 1 << "  ";
         for (int col = COLS - 1; col >= 0; col--) {
             bool is_light_square = (row + col) % 2 == 0;
-            bool has_piece = (board[row][col] != nullptr);
-            char piece_symbol = has_piece ? board[row][col]->symbol : ' ';
-            bool is_white_piece = has_piece && board[row][col]->player == white;
+            bool has_piece = bool(board[square(row, col)]);
+            char piece_symbol = has_piece ? board[square(row, col)].symbol() : ' ';
+            bool is_white_piece = has_piece && board[square(row, col)].player() == white;
             bool is_last_move = (
                 std::array<int, 2>{row, col} == last_move_starting ||
                 std::array<int, 2>{row, col} == last_move_ending
@@ -402,9 +481,9 @@ void Board::print_white_perspective(
             bool is_selected = (row == current_piece[0] && col == current_piece[1]);
             bool is_attack = possible_actions.attacks.count({row, col});
             bool is_move = possible_actions.moves.count({row, col});
-            bool has_piece = (board[row][col] != nullptr);
-            char piece_symbol = has_piece ? board[row][col]->symbol : ' ';
-            bool is_white_piece = has_piece && board[row][col]->player == white;
+            bool has_piece = bool(board[square(row, col)]);
+            char piece_symbol = has_piece ? board[square(row, col)].symbol() : ' ';
+            bool is_white_piece = has_piece && board[square(row, col)].player() == white;
             bool is_last_move = (
                 std::array<int, 2>{row, col} == last_move_starting ||
                 std::array<int, 2>{row, col} == last_move_ending
@@ -457,154 +536,185 @@ void Board::print_white_perspective(
     std::cout << "     a    b    c    d    e    f    g    h  " << std::endl;
 };
 
-// Execute a move on the board
-void Board::make_action(int old_row, int old_col, int new_row, int new_col, char symbol) {
-    // Check if there is a piece at the old position and the move to the new position is legal
-    if (board[old_row][old_col] &&
-        board[old_row][old_col]->check_if_legal_action(new_row, new_col)
-    ) {
-        // Handle en passant capture logic
-        check_enpassant(old_row, old_col, new_row);
-
-        // Update castling rights if the castling state is not default (no castling)
-        if (castling != "____") {
-            check_castling(old_row, old_col);
+// Find the legal move matching the given squares (symbol picks the promotion piece)
+std::optional<Move> Board::find_move(int old_row, int old_col, int new_row, int new_col, char symbol) const {
+    int from = square(old_row, old_col);
+    int to = square(new_row, new_col);
+
+    // Promote to a queen unless another piece of the moving player is requested
+    Piece promoted = Piece::get_piece(symbol);
+    PieceType promotion = (promoted && promoted.player() == turn && promoted.piece() != pawn && promoted.piece() != king)
+        ? promoted.piece()
+        : queen;
+
+    for (const Move& move : legal_moves) {
+        if (move.from() == from && move.to() == to &&
+            (move.flag() != promotion_move || move.promotion() == promotion)
+        ) {
+            return move;
         }
+    }
+    return std::nullopt;
+}
 
-        // Handle promotion
-        if (board[old_row][old_col]->possible_actions.promotion &&
-            symbol != ' ') {
-            board[old_row][old_col] = Board::create_piece(symbol, old_row, old_col);
-        }
+// Make a legal move in place and return the record needed to take it back
+UndoRecord Board::make_move(const Move& move) {
+    int old_square = move.from();
+    int new_square = move.to();
+    auto [old_row, old_col] = position(old_square);
+    auto [new_row, new_col] = position(new_square);
+    Piece moving_piece = board[old_square];
+
+    UndoRecord undo = {
+        move,
+        moving_piece,
+        board[new_square],
+        new_square,
+        castling,
+        enpassant,
+        winner,
+        zobrist_key
+    };
 
-        // Handle castling moves
-        if (board[old_row][old_col]->piece == king && (abs(new_col - old_col) == 2)) {
-            if (new_col == 1) {
-                board[old_row][2] = std::move(board[old_row][0]);
-                board[old_row][0] = nullptr;
+    // Handle en passant capture: the captured pawn stands next to the starting square
+    if (move.flag() == enpassant_move) {
+        undo.captured_square = square(old_row, new_col);
+        undo.captured = board[undo.captured_square];
+    }
 
-                board[old_row][2]->row = old_row;
-                board[old_row][2]->column = 2;
-            } else {
-                board[old_row][4] = std::move(board[old_row][7]);
-                board[old_row][7] = nullptr;
+    // Remove the captured piece
+    if (undo.captured) {
+        remove_piece(undo.captured_square);
+    }
 
-                board[old_row][4]->row = old_row;
-                board[old_row][4]->column = 4;
-            }
+    // Handle en passant logic
+    zobrist_key ^= Zobrist::enpassant_key(enpassant);
+    check_enpassant(old_row, old_col, new_row);
+    zobrist_key ^= Zobrist::enpassant_key(enpassant);
+
+    // Update castling rights if the castling state is not default (no castling)
+    if (castling) {
+        zobrist_key ^= Zobrist::castling_key(castling);
+        check_castling(old_row, old_col);
+        check_castling(new_row, new_col);
+        zobrist_key ^= Zobrist::castling_key(castling);
+    }
+
+    // Handle castling moves
+    if (move.flag() == castling_move) {
+        if (new_col == 1) {
+            move_piece(square(old_row, 0), square(old_row, 2));
+        } else {
+            move_piece(square(old_row, 7), square(old_row, 4));
         }
-        
-        // Move the piece from old position to new position
-        board[new_row][new_col] = std::move(board[old_row][old_col]);
-        
-        // Update the piece's internal position state to the new coordinates
-        board[new_row][new_col]->row = new_row;
-        board[new_row][new_col]->column = new_col;
-        
-        // Switch the turn to the other player after a successful move
-        turn = (turn == white) ? black : white;
-        
-        // Recalculate possible move
-        get_possible_actions();
     }
+
+    // Move the piece from old position to new position
+    move_piece(old_square, new_square);
+
+    // Handle promotion
+    if (move.flag() == promotion_move) {
+        remove_piece(new_square);
+        put_piece(Piece::get_piece(promotion_symbol(move)), new_square);
+    }
+
+    // Switch the turn to the other player after a successful move
+    turn = (turn == white) ? black : white;
+    zobrist_key ^= Zobrist::BLACK_TO_MOVE;
+
+    return undo;
 }
 
-// Generate a new board after a move (AlfaBetaPruning)
-Board Board::make_action_board(int old_row, int old_col, int new_row, int new_col, char symbol) const {
-    Board new_board(*this);
+// Take back the move described by the undo record (possible actions are not restored)
+void Board::unmake_move(const UndoRecord& undo) {
+    turn = (turn == white) ? black : white;
 
-    // Check if there is a piece at the old position and the move to the new position is legal
-    if (board[old_row][old_col] &&
-        board[old_row][old_col]->check_if_legal_action(new_row, new_col)
-    ) {
-        // Handle en passant capture logic
-        new_board.check_enpassant(old_row, old_col, new_row);
+    // Put the original piece back (this also reverts a promotion)
+    remove_piece(undo.move.to());
+    put_piece(undo.piece, undo.move.from());
 
-        // Update castling rights if the castling state is not default (no castling)
-        if (castling != "____") {
-            new_board.check_castling(old_row, old_col);
+    // Move the castling rook back
+    int row = position(undo.move.from())[0];
+    int new_col = position(undo.move.to())[1];
+    if (undo.move.flag() == castling_move) {
+        if (new_col == 1) {
+            move_piece(square(row, 2), square(row, 0));
+        } else {
+            move_piece(square(row, 4), square(row, 7));
         }
+    }
 
-        // Handle promotion
-        if (board[old_row][old_col]->possible_actions.promotion &&
-            symbol != ' ') {
-            new_board.board[old_row][old_col] = Board::create_piece(symbol, old_row, old_col);
-        }
+    // Restore the captured piece
+    if (undo.captured) {
+        put_piece(undo.captured, undo.captured_square);
+    }
 
-        // Handle castling moves
-        if (board[old_row][old_col]->piece == king && (abs(new_col - old_col) == 2)) {
-            if (new_col == 1) {
-                new_board.board[old_row][2] = std::move(new_board.board[old_row][0]);
-                new_board.board[old_row][0] = nullptr;
+    castling = undo.castling;
+    enpassant = undo.enpassant;
+    winner = undo.winner;
+    zobrist_key = undo.zobrist_key;
+}
 
-                new_board.board[old_row][2]->row = old_row;
-                new_board.board[old_row][2]->column = 2;
-            } else {
-                new_board.board[old_row][4] = std::move(new_board.board[old_row][7]);
-                new_board.board[old_row][7] = nullptr;
+UndoRecord Board::make_null_move() {
+    UndoRecord undo = {NO_MOVE, Piece(), Piece(), 0, castling, enpassant, winner, zobrist_key};
 
-                new_board.board[old_row][4]->row = old_row;
-                new_board.board[old_row][4]->column = 4;
-            }
-        }
-        
-        // Move the piece from old position to new position
-        new_board.board[new_row][new_col] = std::move(new_board.board[old_row][old_col]);
-        
-        // Update the piece's internal position state to the new coordinates
-        new_board.board[new_row][new_col]->row = new_row;
-        new_board.board[new_row][new_col]->column = new_col;
-        
-        // Switch the turn to the other player after a successful move
-        new_board.turn = (new_board.turn == white) ? black : white;
+    // Passing gives up the en passant capture
+    zobrist_key ^= Zobrist::enpassant_key(enpassant);
+    enpassant = {8, 8};
+
+    turn = (turn == white) ? black : white;
+    zobrist_key ^= Zobrist::BLACK_TO_MOVE;
+
+    return undo;
+}
+
+void Board::unmake_null_move(const UndoRecord& undo) {
+    turn = (turn == white) ? black : white;
+    enpassant = undo.enpassant;
+    zobrist_key = undo.zobrist_key;
+}
+
+// Execute a move on the board
+void Board::make_action(int old_row, int old_col, int new_row, int new_col, char symbol) {
+    // Check if there is a piece at the old position and the move to the new position is legal
+    if (auto move = find_move(old_row, old_col, new_row, new_col, symbol)) {
+        make_move(*move);
+
+        // Recalculate possible move
+        get_possible_actions();
+    }
+}
+
+// Generate a new board after a move
+Board Board::make_action_board(int old_row, int old_col, int new_row, int new_col, char symbol) const {
+    Board new_board(*this);
+
+    // Check if there is a piece at the old position and the move to the new position is legal
+    if (auto move = find_move(old_row, old_col, new_row, new_col, symbol)) {
+        new_board.make_move(*move);
     }
     return new_board;
 }
 
 // Generate AI's move
 void Board::computer_action(Game& game) {
+    // Search deeper and deeper until the game's depth or time limit is reached
+    SearchResult result = game.alfa_beta_pruning.iterative_deepening(*this, game.search_limits, 10);
+
+    // Without a legal move the game is over, there is nothing to play
+    if (result.root_moves.empty()) return;
+
     // Store all possible actions the AI can take
     std::vector<Action> actions;
-    // Store possible promotion pieces for pawn promotion
-    std::vector<char> symbols;
-
-    for (auto position : active_pieces) {
-        for (auto move : board[position[0]][position[1]]->possible_actions) {
-            // Check if the current piece can promote
-            if (board[position[0]][position[1]]->possible_actions.promotion) {
-                // Define possible promotion pieces depending on the current turn color
-                if (turn == white) {
-                    symbols = {'Q', 'N', 'R', 'B'};
-                } else {
-                    symbols = {'q', 'n', 'r', 'b'};
-                }
-
-            } else {
-                // No promotion
-                symbols = {' '};
-            }
-            
-            // Evaluate the move
-            for (char curr_symbol : symbols) {
-                // Create an Action representing the move
-                Action curr_action(
-                    {position[0], position[1]},
-                    {move[0], move[1]},
-                    curr_symbol,
-                    game.alfa_beta_pruning(
-                        make_action_board(
-                            position[0],
-                            position[1],
-                            move[0],
-                            move[1],
-                            curr_symbol
-                        ), 2, -100000, 100000)
-                );
-
-                // Add this evaluated action to the list of possible actions
-                actions.push_back(curr_action);
-            }
-        }
+    actions.reserve(result.root_moves.size());
+    for (const RootMove& root_move : result.root_moves) {
+        // Create an Action representing the move
+        actions.emplace_back(
+            position(root_move.move.from()),
+            position(root_move.move.to()),
+            promotion_symbol(root_move.move),
+            root_move.score
+        );
     }
 
     // Sort the actions based on their rating, descending for white and ascending for black
@@ -644,53 +754,208 @@ void Board::computer_action(Game& game) {
     );
 }
 
-// Helper functions for creating pieces
-template <typename T>
-std::unique_ptr<Piece> create_piece_unique(const char& symbol, PieceType piece, PlayerColor player, int row, int col) {
-    return std::make_unique<T>(symbol, piece, player, row, col);
+// Place a piece on an empty square
+void Board::put_piece(Piece piece, int square) {
+    Bitboard bb = square_bb(square);
+
+    pieces[piece.index()] |= bb;
+    occupancy[piece.player()] |= bb;
+    occupied |= bb;
+    board[square] = piece;
+    zobrist_key ^= Zobrist::PIECES[piece.index()][square];
 }
 
-std::unique_ptr<Piece> Board::create_piece(
-    char symbol,
-    int row,
-    int col
-) const {
-    // Determine player color
-    PlayerColor player = isupper(symbol) ? white : black;
+// Remove the piece standing on a square
+void Board::remove_piece(int square) {
+    Piece piece = board[square];
+    Bitboard bb = square_bb(square);
 
-    char upperSymbol = toupper(symbol);
+    pieces[piece.index()] &= ~bb;
+    occupancy[piece.player()] &= ~bb;
+    occupied &= ~bb;
+    board[square] = Piece();
+    zobrist_key ^= Zobrist::PIECES[piece.index()][square];
+}
 
-    // Create the appropriate piece based on the symbol
-    switch (upperSymbol) {
-        case 'R': return create_piece_unique<Rook>(symbol, rook, player, row, col);
-        case 'N': return create_piece_unique<Knight>(symbol, knight, player, row, col);
-        case 'B': return create_piece_unique<Bishop>(symbol, bishop, player, row, col);
-        case 'K': return create_piece_unique<King>(symbol, king, player, row, col);
-        case 'Q': return create_piece_unique<Queen>(symbol, queen, player, row, col);
-        default:  return create_piece_unique<Pawn>(symbol, pawn, player, row, col);
-    }
+// Move a piece to an empty square
+void Board::move_piece(int from, int to) {
+    Piece piece = board[from];
+    Bitboard from_to = square_bb(from) | square_bb(to);
+
+    pieces[piece.index()] ^= from_to;
+    occupancy[piece.player()] ^= from_to;
+    occupied ^= from_to;
+    board[from] = Piece();
+    board[to] = piece;
+    zobrist_key ^= Zobrist::PIECES[piece.index()][from] ^ Zobrist::PIECES[piece.index()][to];
 }
 
-// Flattens all checking positions into an unordered set for faster lookups
-PositionSet Board::flatting_checkin_pieces(
-    const PositionMap& checkin_pieces
-) const {
-    PositionSet checking_positions;
-    // Check if only one piece checking the king, if more moving the king is the only solution
-    if (checkin_pieces.size() == 1) {
-        for (auto key : checkin_pieces) {
-            checking_positions.insert(key.first);
-            for (auto value : key.second) {
-                checking_positions.insert(value);
+// Check if the square is attacked by any piece of the given player
+bool Board::is_attacked(int square, PlayerColor by) const {
+    // Look from the square with the attacks of every piece kind, a pawn of the other color standing in for the pawns
+    Bitboard rooks_queens = get_pieces(rook, by) | get_pieces(queen, by);
+    Bitboard bishops_queens = get_pieces(bishop, by) | get_pieces(queen, by);
+
+    return (PAWN_ATTACKS[(by == white) ? black : white][square] & get_pieces(pawn, by)) ||
+           (KNIGHT_ATTACKS[square] & get_pieces(knight, by)) ||
+           (KING_ATTACKS[square] & get_pieces(king, by)) ||
+           (rook_attacks(square, occupied) & rooks_queens) ||
+           (bishop_attacks(square, occupied) & bishops_queens);
+}
+
+// Static exchange evaluation with the swap algorithm
+int Board::see(const Move& move) const {
+    int to = move.to();
+    Piece captured = board[to];
+
+    // Gains of the exchange, gain[d] is the score of the player making capture d if the exchange stopped there
+    std::array<int, 32> gain;
+    int d = 0;
+    gain[0] = captured ? captured.get_value() : (move.flag() == enpassant_move ? 1 : 0);
+
+    int attacker_square = move.from();
+    int attacker_value = board[attacker_square].get_value();
+    Bitboard occupied_squares = occupied;
+
+    if (move.flag() == promotion_move) {
+        int promoted_value = Piece(move.promotion(), turn).get_value();
+        gain[0] += promoted_value - attacker_value;
+        attacker_value = promoted_value;
+    } else if (move.flag() == enpassant_move) {
+        occupied_squares ^= square_bb(square(attacker_square / 8, to % 8));
+    }
+
+    Bitboard rooks_queens = get_pieces(rook, white) | get_pieces(queen, white) |
+                            get_pieces(rook, black) | get_pieces(queen, black);
+    Bitboard bishops_queens = get_pieces(bishop, white) | get_pieces(queen, white) |
+                              get_pieces(bishop, black) | get_pieces(queen, black);
+
+    Bitboard attackers = attackers_to(to, occupied_squares);
+    PlayerColor side = turn;
+
+    while (true) {
+        d++;
+        gain[d] = attacker_value - gain[d - 1];
+
+        // Neither continuing nor stopping the exchange can change its result any more
+        if (std::max(-gain[d - 1], gain[d]) < 0) break;
+
+        // The capturing piece leaves its square, uncovering the sliders behind it (x-rays)
+        occupied_squares ^= square_bb(attacker_square);
+        attackers |= (rook_attacks(to, occupied_squares) & rooks_queens) |
+                     (bishop_attacks(to, occupied_squares) & bishops_queens);
+        attackers &= occupied_squares;
+
+        side = opponent_of(side);
+        Bitboard own_attackers = attackers & occupancy[side];
+        if (!own_attackers) break;
+
+        // Least valuable attacker, the king only captures onto an undefended square
+        PieceType attacker = pawn;
+        for (PieceType piece : {pawn, knight, bishop, rook, queen, king}) {
+            if (own_attackers & get_pieces(piece, side)) {
+                attacker = piece;
+                break;
             }
         }
+        if (attacker == king && (attackers & occupancy[opponent_of(side)])) break;
+
+        attacker_square = lowest_square(own_attackers & get_pieces(attacker, side));
+        attacker_value = Piece(attacker, side).get_value();
+    }
+
+    // Each player may stop the exchange instead of capturing, fold the gains back to the first capture
+    while (--d) {
+        gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+    }
+    return gain[0];
+}
+
+// Pieces of both players attacking the square for the given occupancy
+Bitboard Board::attackers_to(int square, Bitboard occupied_squares) const {
+    Bitboard rooks_queens = get_pieces(rook, white) | get_pieces(queen, white) |
+                            get_pieces(rook, black) | get_pieces(queen, black);
+    Bitboard bishops_queens = get_pieces(bishop, white) | get_pieces(queen, white) |
+                              get_pieces(bishop, black) | get_pieces(queen, black);
+
+    return (PAWN_ATTACKS[black][square] & get_pieces(pawn, white)) |
+           (PAWN_ATTACKS[white][square] & get_pieces(pawn, black)) |
+           (KNIGHT_ATTACKS[square] & (get_pieces(knight, white) | get_pieces(knight, black))) |
+           (KING_ATTACKS[square] & (get_pieces(king, white) | get_pieces(king, black))) |
+           (rook_attacks(square, occupied_squares) & rooks_queens) |
+           (bishop_attacks(square, occupied_squares) & bishops_queens);
+}
+
+// Squares attacked by all pieces of the given player for the given occupancy
+Bitboard Board::attacks_by(PlayerColor by, Bitboard occupied_squares) const {
+    Bitboard attacks = pawn_attacks(get_pieces(pawn, by), by);
+
+    Bitboard knights = get_pieces(knight, by);
+    while (knights) {
+        attacks |= KNIGHT_ATTACKS[pop_square(knights)];
+    }
+
+    Bitboard rooks_queens = get_pieces(rook, by) | get_pieces(queen, by);
+    while (rooks_queens) {
+        attacks |= rook_attacks(pop_square(rooks_queens), occupied_squares);
+    }
+
+    Bitboard bishops_queens = get_pieces(bishop, by) | get_pieces(queen, by);
+    while (bishops_queens) {
+        attacks |= bishop_attacks(pop_square(bishops_queens), occupied_squares);
+    }
+
+    Bitboard king_bb = get_pieces(king, by);
+    if (king_bb) {
+        attacks |= KING_ATTACKS[lowest_square(king_bb)];
+    }
+    return attacks;
+}
+
+// Find the checking and pinned pieces with a single pass from the king square
+void Board::update_checks_and_pins() {
+    checkers = 0;
+    pinned = 0;
+    check_mask = ~Bitboard(0);
+
+    Bitboard king_bb = get_pieces(king, turn);
+    if (!king_bb) return;
+
+    PlayerColor opponent = (turn == white) ? black : white;
+    int king_square = lowest_square(king_bb);
+
+    // Knights and pawns check from the squares the king would attack as that piece
+    checkers = (KNIGHT_ATTACKS[king_square] & get_pieces(knight, opponent)) |
+               (PAWN_ATTACKS[turn][king_square] & get_pieces(pawn, opponent));
+
+    // Sliders on a line with the king give check, or pin a single own piece standing in between
+    Bitboard rooks_queens = get_pieces(rook, opponent) | get_pieces(queen, opponent);
+    Bitboard bishops_queens = get_pieces(bishop, opponent) | get_pieces(queen, opponent);
+    Bitboard sliders = (rook_attacks(king_square, 0) & rooks_queens) |
+                       (bishop_attacks(king_square, 0) & bishops_queens);
+
+    while (sliders) {
+        int slider = pop_square(sliders);
+        Bitboard blockers = BETWEEN[king_square][slider] & occupied;
+
+        if (!blockers) {
+            checkers |= square_bb(slider);
+        } else if (count_squares(blockers) == 1 && (blockers & occupancy[turn])) {
+            pinned |= blockers;
+        }
+    }
+
+    // A single check can be resolved by capturing or blocking, a double check only by moving the king
+    if (checkers) {
+        check_mask = (count_squares(checkers) == 1)
+            ? checkers | BETWEEN[king_square][lowest_square(checkers)]
+            : 0;
     }
-    return checking_positions;
 }
 
 // Handle en passant logic during a move
 void Board::check_enpassant(int old_row, int old_col, int new_row) {
-    if (board[old_row][old_col]->piece == pawn &&
+    if (board[square(old_row, old_col)].piece() == pawn &&
         ((old_row == 1 && new_row == 3) ||
         (old_row == 6 && new_row == 4))) {
             enpassant = {(old_row + new_row) / 2, old_col};
@@ -699,35 +964,43 @@ void Board::check_enpassant(int old_row, int old_col, int new_row) {
     }
 }
 
-// Handle castling logic during a move
-void Board::check_castling(int old_row, int old_col) {
-    std::unordered_map<
-    std::array<int, 2>,
-    std::vector<int>,
-    PositionHash
-    > kings_rooks_positions = {
-        {{0, 3}, {0, 1}}, // The white king
-        {{7, 3}, {2, 3}}, // The black king
-        {{0, 0}, {0}}, // The white rook on the king side
-        {{0, 7}, {1}}, // The white rook on the queen side
-        {{7, 0}, {2}}, // The black rook on the king side
-        {{7, 7}, {3}} // The black rook on the queen side
-    };
-    
-    if (kings_rooks_positions.count({old_row, old_col})) {
-        for (auto index : kings_rooks_positions[{old_row, old_col}]) {
-            castling[index] = '_';
-        }
+// Castling rights (CastlingRight bits) from text such as "KQ__"
+std::uint8_t Board::parse_castling(const std::string& castling) {
+    std::uint8_t rights = 0;
+    for (std::size_t i = 0; i < 4 && i < castling.size(); i++) {
+        if (castling[i] == "KQkq"[i]) rights |= 1 << i;
+    }
+    return rights;
+}
+
+// Handle castling logic during a move (moving from or capturing on the given square)
+void Board::check_castling(int row, int col) {
+    switch (square(row, col)) {
+        case square(0, 3): castling &= ~(white_kingside | white_queenside); break; // The white king
+        case square(7, 3): castling &= ~(black_kingside | black_queenside); break; // The black king
+        case square(0, 0): castling &= ~white_kingside; break; // The white rook on the king side
+        case square(0, 7): castling &= ~white_queenside; break; // The white rook on the queen side
+        case square(7, 0): castling &= ~black_kingside; break; // The black rook on the king side
+        case square(7, 7): castling &= ~black_queenside; break; // The black rook on the queen side
     }
 }
 
 // Promote a pawn and create the promoted piece
-std::unique_ptr<Piece> Board::create_promoted_piece_player(int row, int col) const {
+Piece Board::create_promoted_piece_player() const {
     char symbol;
     std::cout << "Pick a promotion [Q, R, N, B, P]: ";
     std::cin >> symbol;
 
-    return Board::create_piece(symbol, row, col);
+    return Piece::get_piece(symbol);
+}
+
+// Symbol of the piece a move promotes to (' ' if the move is not a promotion)
+char Board::promotion_symbol(const Move& move) const {
+    if (move.flag() != promotion_move) return ' ';
+
+    // Indexed by PieceType, the promoting player is the one to move
+    char symbol = " RNBQ"[move.promotion()];
+    return (turn == black) ? char(std::tolower(symbol)) : symbol;
 }
 
 // Select a random action from a set of best possible actions
@@ -737,4 +1010,4 @@ Action Board::get_random_element(std::span<const Action> best_actions) const {
 
     std::uniform_int_distribution<size_t> dist(0, best_actions.size() - 1);
     return best_actions[dist(gen)];
-}
\ No newline at end of file
+}
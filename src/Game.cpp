@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "Game.h"
 #include "Board.h"
 #include "Piece.h"
@@ -6,7 +8,10 @@ Game::Game()
     : current_board(),
       valid_format("[1-8][A-Ha-h]"),
       last_move_starting({-1, -1}),
-      last_move_ending({-1, -1}) {
+      last_move_ending({-1, -1}),
+      search_limits({.depth = 3}) {
+    // The AI searches on every core of the machine
+    alfa_beta_pruning.set_threads(int(std::thread::hardware_concurrency()));
 }
 
 int Game::menu() {
@@ -192,12 +197,12 @@ void Game::player_pick_destination(
     std::array<int, 2> curr_row_col = curr_notation.parse_square_notation();
 
     // Verify the selected piece exists and belongs to the player
-    if (current_board.board[curr_row_col[0]][curr_row_col[1]] &&
-        current_board.board[curr_row_col[0]][curr_row_col[1]]->player == white) {
+    Piece current_piece = current_board.board[square(curr_row_col[0], curr_row_col[1])];
+    if (current_piece && current_piece.player() == white) {
         // Show board with possible moves highlighted for the selected piece
         current_board.print_white_perspective(
             last_move_starting, last_move_ending, curr_row_col,
-            current_board.board[curr_row_col[0]][curr_row_col[1]]->possible_actions
+            current_board.get_actions(curr_row_col[0], curr_row_col[1])
         );
     } else {
         message = "You need to pick your own piece!";
@@ -223,8 +228,9 @@ void Game::player_pick_destination(
         std::array<int, 2> next_row_col = next_notation.parse_square_notation();
 
         // Check if destination is a valid move or attack for the selected piece
-        if (current_board.board[curr_row_col[0]][curr_row_col[1]]->possible_actions.moves.count({next_row_col[0], next_row_col[1]}) ||
-        current_board.board[curr_row_col[0]][curr_row_col[1]]->possible_actions.attacks.count({next_row_col[0], next_row_col[1]})) {
+        const Actions& current_actions = current_board.get_actions(curr_row_col[0], curr_row_col[1]);
+        if (current_actions.moves.count({next_row_col[0], next_row_col[1]}) ||
+        current_actions.attacks.count({next_row_col[0], next_row_col[1]})) {
             auto symbol = get_symbol(curr_row_col);
             if (symbol) {
                 // Update last move positions for display and apply the move
@@ -251,7 +257,7 @@ std::expected<char, std::string> Game::get_symbol(const std::array<int, 2>& curr
     char symbol;
 
     // Check if the move requires promotion choice
-    if (current_board.board[curr_row_col[0]][curr_row_col[1]]->possible_actions.promotion) {
+    if (current_board.get_actions(curr_row_col[0], curr_row_col[1]).promotion) {
         std::cout << "Pick a promotion [Q, R, N, B]: ";
 
         // Get user input for promotion piece
@@ -338,20 +344,16 @@ void Game::save_board() const {
     std::ofstream SaveFile("save.txt");
 
     // Save board state: piece symbols or space for empty squares
-    for (auto &current_row : current_board.board) {
-        for (auto &piece : current_row) {
-            if (piece) {
-                SaveFile << piece->symbol;
-            } else {
-                SaveFile << ' ';
-            }
+    for (int row = 0; row < current_board.ROWS; row++) {
+        for (int col = 0; col < current_board.COLS; col++) {
+            SaveFile << current_board.get_symbol(row, col);
         }
         SaveFile << std::endl;
     }
 
     // Save additional board info: turn, castling rights, en passant square
     SaveFile << current_board.turn << std::endl;
-    SaveFile << current_board.castling << std::endl;
+    SaveFile << current_board.castling_string() << std::endl;
     SaveFile << current_board.enpassant[0] << current_board.enpassant[1] << std::endl;
 
     SaveFile.close();
@@ -0,0 +1,172 @@
+#include "MovePicker.h"
+
+MovePicker::MovePicker(const Board& board)
+    : board(nullptr),
+      analysed(true),
+      history(nullptr),
+      hash_move(NO_MOVE),
+      killers({NO_MOVE, NO_MOVE}),
+      stage(all_stage),
+      moves(board.legal_moves) {
+    for (int i = 0; i < moves.size(); i++) {
+        scores[i] = mvv_lva(board, moves[i]);
+    }
+}
+
+MovePicker::MovePicker(Board& board, Move hash_move, const KillerMoves& killers, const HistoryTable& history)
+    : board(&board),
+      analysed(true),
+      history(&history),
+      hash_move(hash_move),
+      killers(killers),
+      stage(hash_stage) {
+    // The legal moves are the scratch space of the generation, older moves are not needed
+    board.legal_moves.clear();
+}
+
+Move MovePicker::next() {
+    Move move = pick_next();
+
+    // The caller searches the move, which leaves the analysis of a child position on the board
+    analysed = false;
+    return move;
+}
+
+Move MovePicker::pick_next() {
+    while (true) {
+        switch (stage) {
+            case hash_stage:
+                stage = generate_captures_stage;
+
+                // The move comes from the table, it may belong to another position
+                refresh_analysis();
+                if (hash_move != NO_MOVE && board->is_legal(hash_move)) {
+                    return hash_move;
+                }
+                break;
+
+            case generate_captures_stage:
+                stage = captures_stage;
+                load_stage(captures);
+                break;
+
+            case captures_stage:
+                while (true) {
+                    Move move = pick_best();
+                    if (move == NO_MOVE) break;
+                    if (move == hash_move) continue;
+
+                    // Losing captures wait until the quiet moves have been tried
+                    if (board->see(move) < 0) {
+                        bad_captures.push_back(move);
+                        continue;
+                    }
+                    return move;
+                }
+                stage = killers_stage;
+                current = 0;
+                break;
+
+            case killers_stage:
+                // The killers come from sibling nodes, they have to be quiet and legal here
+                refresh_analysis();
+                while (current < 2) {
+                    Move move = killers[current++];
+                    if (move != NO_MOVE && move != hash_move &&
+                        !is_tactical(*board, move) && board->is_legal(move)
+                    ) {
+                        return move;
+                    }
+                }
+                stage = generate_quiets_stage;
+                break;
+
+            case generate_quiets_stage:
+                stage = quiets_stage;
+                load_stage(quiets);
+                break;
+
+            case quiets_stage:
+                while (true) {
+                    Move move = pick_best();
+                    if (move == NO_MOVE) break;
+                    if (is_special(move)) continue;
+                    return move;
+                }
+                stage = bad_captures_stage;
+                break;
+
+            case bad_captures_stage:
+                if (current_bad < bad_captures.size()) {
+                    return bad_captures[current_bad++];
+                }
+                stage = done_stage;
+                break;
+
+            case all_stage:
+                return pick_best();
+
+            case done_stage:
+                return NO_MOVE;
+        }
+    }
+}
+
+void MovePicker::refresh_analysis() {
+    if (!analysed) {
+        board->update_analysis();
+        analysed = true;
+    }
+}
+
+void MovePicker::load_stage(GenerationType type) {
+    refresh_analysis();
+    board->legal_moves.clear();
+    board->add_legal_moves(type);
+    moves = board->legal_moves;
+    current = 0;
+
+    for (int i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+        if (type == captures) {
+            scores[i] = mvv_lva(*board, move);
+        } else {
+            scores[i] = (*history)[board->turn][move.from()][move.to()];
+        }
+    }
+}
+
+Move MovePicker::pick_best() {
+    if (current == moves.size()) return NO_MOVE;
+
+    // Selection sort step: move the best remaining move to the front of the remaining ones
+    int best = current;
+    for (int i = current + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    std::swap(moves[current], moves[best]);
+    std::swap(scores[current], scores[best]);
+
+    return moves[current++];
+}
+
+bool MovePicker::is_special(const Move& move) const {
+    return move == hash_move || move == killers[0] || move == killers[1];
+}
+
+bool MovePicker::is_tactical(const Board& board, const Move& move) {
+    // Underpromotions are quiet moves, even when they capture
+    if (move.flag() == promotion_move) return move.promotion() == queen;
+    return board.board[move.to()] || move.flag() == enpassant_move;
+}
+
+int MovePicker::mvv_lva(const Board& board, const Move& move) {
+    Piece captured = board.board[move.to()];
+    int victim = captured ? captured.get_value() : (move.flag() == enpassant_move ? 1 : 0);
+
+    // A queen promotion wins about as much as capturing a queen
+    if (move.flag() == promotion_move && move.promotion() == queen) {
+        victim += Piece(queen, white).get_value();
+    }
+    return victim * 64 - board.board[move.from()].get_value();
+}
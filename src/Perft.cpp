@@ -0,0 +1,39 @@
+#include "Perft.h"
+
+std::uint64_t perft(Board& board, int depth) {
+    if (depth <= 0) return 1;
+
+    board.get_possible_actions();
+
+    // Leaves are not visited, every legal move of the last ply is one node
+    if (depth == 1) return board.legal_moves.size();
+
+    // Copy the moves first, the legal moves are overwritten by the child nodes
+    MoveList moves = board.legal_moves;
+    std::uint64_t nodes = 0;
+
+    for (const Move& move : moves) {
+        UndoRecord undo = board.make_move(move);
+        nodes += perft(board, depth - 1);
+        board.unmake_move(undo);
+    }
+    return nodes;
+}
+
+std::uint64_t perft_divide(Board& board, int depth, std::ostream& out) {
+    if (depth <= 0) return 1;
+
+    board.get_possible_actions();
+    MoveList moves = board.legal_moves;
+    std::uint64_t nodes = 0;
+
+    for (const Move& move : moves) {
+        UndoRecord undo = board.make_move(move);
+        std::uint64_t move_nodes = perft(board, depth - 1);
+        board.unmake_move(undo);
+
+        out << move.uci() << ": " << move_nodes << std::endl;
+        nodes += move_nodes;
+    }
+    return nodes;
+}
\ No newline at end of file
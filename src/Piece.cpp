@@ -2,852 +2,368 @@
 #include "Piece.h"
 #include "Types.h"
 
-// Constructor
-Piece::Piece(
-    const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    const int& input_row,
-    const int& input_column)
-    : symbol(input_symbol),
-      piece(input_piece),
-      player(input_player),
-      row(input_row),
-      column(input_column),
-      possible_actions() {
-}
+// Character symbol representing the piece (' ' for an empty square)
+char Piece::symbol() const {
+    if (!data) return ' ';
 
-// Comparison operators for equality
-bool Piece::operator==(const Piece& other) const {
-    return (typeid(*this) == typeid(other) &&
-            this->symbol == other.symbol &&
-            this->piece == other.piece &&
-            this->player == other.player &&
-            this->row == other.row &&
-            this->column == other.column);
+    // Indexed by PieceType
+    char symbol = "PRNBQK"[piece()];
+    return (player() == black) ? char(std::tolower(symbol)) : symbol;
 }
 
-// Comparison operators for inequality
-bool Piece::operator!=(const Piece& other) const {
-    return !(*this == other);
+// Get the point value of the piece
+int Piece::get_value() const {
+    // Indexed by PieceType
+    static constexpr std::array<int, 6> values = {1, 5, 3, 3, 9, 50};
+    return values[piece()];
 }
 
 // Overloaded output stream operator for Piece
 std::ostream& operator<<(std::ostream& out, const Piece& piece) {
-    out << "Symbol: " << piece.symbol << ", ";
-    out << "Piece: " << piece.piece << ", ";
-    out << "Player: " << piece.player << ", ";
-    out << "Position: (" << piece.row << ", " << piece.column << ")";
+    out << "Symbol: " << piece.symbol() << ", ";
+    out << "Piece: " << piece.piece() << ", ";
+    out << "Player: " << piece.player();
     return out;
 };
 
-// Check if a position is within the board bounds
-bool Piece::is_valid_position(const Board& board, const int& row, const int& column) const{
-    return row >= 0 && row < board.ROWS && column >= 0 && column < board.COLS;
+// Piece for the given symbol, an empty square for any other character
+Piece Piece::get_piece(char symbol) {
+    switch (symbol) {
+        case 'P': return Piece(pawn, white);
+        case 'R': return Piece(rook, white);
+        case 'N': return Piece(knight, white);
+        case 'B': return Piece(bishop, white);
+        case 'Q': return Piece(queen, white);
+        case 'K': return Piece(king, white);
+        case 'p': return Piece(pawn, black);
+        case 'r': return Piece(rook, black);
+        case 'n': return Piece(knight, black);
+        case 'b': return Piece(bishop, black);
+        case 'q': return Piece(queen, black);
+        case 'k': return Piece(king, black);
+        default:  return Piece();
+    }
+}
+
+// Squares attacked by the piece standing on the given square
+template<PlayerColor Us>
+Bitboard Piece::attacks(const Board& board_class, int square) const {
+    switch (piece()) {
+        case pawn:   return PAWN_ATTACKS[Us][square];
+        case knight: return KNIGHT_ATTACKS[square];
+        case bishop: return bishop_attacks(square, board_class.occupied);
+        case rook:   return rook_attacks(square, board_class.occupied);
+        case queen:  return queen_attacks(square, board_class.occupied);
+        case king:   return KING_ATTACKS[square];
+    }
+    return 0;
 }
 
-// Checks if moving the piece will not expose the king to a check (i.e., the piece is not pinned)
-bool Piece::is_not_pinned(
-    const std::array<int, 2>& piece_position,
-    const std::array<int, 2>& move,
+// Squares the piece may move to without leaving the king in check (pins and check evasions)
+Bitboard Piece::legal_targets(
     const Board& board_class,
-    const PositionMap& pinned_pieces
+    int square
 ) const {
-    return (
-        player != board_class.turn ||
-        !pinned_pieces.count(piece_position) ||
-        (
-            pinned_pieces.count(piece_position) &&
-            pinned_pieces.at(piece_position).count(move)
-        )
-    );
+    return board_class.check_mask & board_class.pin_mask(square);
 }
 
-// Derived class representing a Pawn
-Pawn::Pawn(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Derived class representing a Knight
-Knight::Knight(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Derived class representing a King
-King::King(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Derived class representing a Rook
-Rook::Rook(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Derived class representing a Bishop
-Bishop::Bishop(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Derived class representing a Queen
-Queen::Queen(const char& input_symbol,
-    const PieceType& input_piece,
-    const PlayerColor& input_player,
-    int input_row,
-    int input_column
-): Piece(input_symbol, input_piece, input_player, input_row, input_column) {}
-
-// Helper method for rook, bishop, and queen movement logic
-void Piece::rook_bishop_queen_move_template_active_player(
+// Add the legal moves of the piece for the active player's turn
+template<PlayerColor Us, GenerationType Type>
+void Piece::check_piece_possible_moves_active_player(
     Board& board_class,
-    const std::vector<std::array<int, 2>>& directions
+    int square
 ) const {
-    // Handles opponent's turn: updates attacked positions and pins
-    for (auto direction : directions) {
-        int distance = 1; // Distance increment along a direction
-        PositionSet current_direction; // Tracks valid positions in the current direction
-        bool absolute_pin_check = false; // Tracks if a piece is pinned
-        std::array<int, 2> pinned_piece; // Coordinates of the pinned piece
-
-        while (true) {
-            int new_row = row + distance * direction[0];
-            int new_column = column + distance * direction[1];
-
-            // Break if the position is invalid (outside the board)
-            if (!is_valid_position(board_class, new_row, new_column)) break;
-
-            if (board_class.board[new_row][new_column]) {
-                // Logic for opponent pieces and pins
-                if (board_class.board[new_row][new_column]->player != player && !absolute_pin_check) {
-                    pinned_piece = {new_row, new_column};
-                    board_class.attacked_positions.insert({new_row, new_column});
-
-                    // Special handling for interaction with the king
-                    if (board_class.board[new_row][new_column]->piece == king &&
-                        board_class.board[new_row][new_column]->player != player
-                    ) {
-                        board_class.checkin_pieces[{row, column}] = current_direction;
-                        int next_row = row + (distance + 1) * direction[0];
-                        int next_column = column + (distance + 1) * direction[1];
-
-                        if (is_valid_position(board_class, new_row, new_column)) {
-                            board_class.attacked_positions.insert({next_row, next_column});
-                        }
-
-                        break;
-                    } else {
-                        absolute_pin_check = true; // Piece encountered is pinned
-                    }
-                } else if (board_class.board[new_row][new_column]->player == player && !absolute_pin_check) {
-                    // If the move results in attacking its own piece
-                    board_class.attacked_positions.insert({new_row, new_column});
-                    break;
-                } else if (absolute_pin_check) {
-                    // If the pinned piece is the king, update pin data
-                    if (board_class.board[new_row][new_column]->piece == king &&
-                        board_class.board[new_row][new_column]->player != player
-                    ) {
-                        board_class.pinned_pieces[pinned_piece].insert({row, column});
-                        board_class.pinned_pieces[pinned_piece].insert(current_direction.begin(), current_direction.end());
-                    }
-                    break;
-                } else {
-                    break;
-                }
-            } else {
-                // Updates attacked positions if no piece is encountered
-                if (!absolute_pin_check) {
-                    board_class.attacked_positions.insert({new_row, new_column});
-                }
-                current_direction.insert({new_row, new_column});
-            }
-            distance++;
-        }
+    switch (piece()) {
+        case pawn: pawn_possible_moves_active_player<Us, Type>(board_class, square); break;
+        case king: king_possible_moves_active_player<Us, Type>(board_class, square); break;
+        // Knight moves share the target filtering with the sliding pieces
+        default:   rook_bishop_queen_move_template_opponent<Us, Type>(board_class, square, attacks<Us>(board_class, square)); break;
     }
 }
 
-void Piece::rook_bishop_queen_move_template_opponent(
+// Update the piece's rating for the opponent: every attacked square counts
+template<PlayerColor Us>
+void Piece::update_rating_opponent(
     Board& board_class,
-    const std::vector<std::array<int, 2>>& directions,
-    const PositionSet& checking_positions
-) {
-    // Handles current player's turn: adds valid moves and attacks
-    for (auto direction : directions) {
-        int distance = 1;
-        while (true) {
-            int new_row = row + distance * direction[0];
-            int new_column = column + distance * direction[1];
-
-            // Break if the position is invalid (outside the board)
-            if (!is_valid_position(board_class, new_row, new_column)) break;
-
-            if (board_class.board[new_row][new_column]) {
-                // Checks for attacks
-                if (board_class.board[new_row][new_column]->player != player &&
-                    is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                    (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-                ) {
-                    possible_actions.attacks.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-                break;
-            } else {
-                // Adds valid moves
-                if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                    (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-                ) {
-                    possible_actions.moves.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-            }
-            distance++;
-        }
-    }
+    int square
+) const {
+    rook_bishop_queen_rating_template_active_player<Us>(board_class, attacks<Us>(board_class, square));
 }
 
-void Piece::rook_bishop_queen_rating_template_active_player(
+// Update the piece's rating for the active player
+template<PlayerColor Us>
+void Piece::update_rating_active_player(
     Board& board_class,
-    const std::vector<std::array<int, 2>>& directions
-) {
-    // Handles opponent's turn: updates attacked positions and pins
-    for (auto direction : directions) {
-        int distance = 1; // Distance increment along a direction
-
-        while (true) {
-            int new_row = row + distance * direction[0];
-            int new_column = column + distance * direction[1];
-
-            // Break if the position is invalid (outside the board)
-            if (!is_valid_position(board_class, new_row, new_column)) break;
-
-            update_move_rating_helping(board_class, player, new_row, new_column);
-
-            if (board_class.board[new_row][new_column]) break;
-
-            distance++;
-        }
+    int square
+) const {
+    switch (piece()) {
+        case pawn: pawn_rating_active_player<Us>(board_class, square); break;
+        case king: king_rating_active_player<Us>(board_class, square); break;
+        default:   rook_bishop_queen_rating_template_opponent<Us>(board_class, square, attacks<Us>(board_class, square)); break;
     }
 }
 
-void Piece::rook_bishop_queen_rating_template_opponent(
+// Helper method for rook, bishop, and queen movement logic
+template<PlayerColor Us, GenerationType Type>
+void Piece::rook_bishop_queen_move_template_opponent(
     Board& board_class,
-    const std::vector<std::array<int, 2>>& directions,
-    const PositionSet& checking_positions
-) {
-    // Handles current player's turn: adds valid moves and attacks
-    for (auto direction : directions) {
-        int distance = 1;
-        while (true) {
-            int new_row = row + distance * direction[0];
-            int new_column = column + distance * direction[1];
-
-            // Break if the position is invalid (outside the board)
-            if (!is_valid_position(board_class, new_row, new_column)) break;
-
-            // Checks for attacks
-            if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-            ) {
-                update_move_rating_helping(board_class, player, new_row, new_column);
-            }
-
-            if (board_class.board[new_row][new_column]) break;
-
-            distance++;
-        }
+    int square,
+    Bitboard attacks
+) const {
+    // Handles current player's turn: adds the moves allowed by pins and checks
+    Bitboard targets = attacks & ~board_class.occupancy[Us] & legal_targets(board_class, square);
+    if constexpr (Type == captures) {
+        targets &= board_class.occupancy[opponent_of(Us)];
+    } else if constexpr (Type == quiets) {
+        targets &= ~board_class.occupancy[opponent_of(Us)];
     }
-}
-
-void Pawn::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Determine movement direction based on the pawn's color
-    int direction_by_colour = player == white ? 1: -1;
-
-    // Initialize possible forward directions for pawn movement
-    std::vector<std::array<int, 2>> directions = {{direction_by_colour, 0}};
-
-    // Add double move direction if the pawn is in its starting position
-    if ((player == white && row == 1) || (player == black && row == 6)) {
-        directions.push_back({direction_by_colour * 2, 0});
+    while (targets) {
+        board_class.legal_moves.push_back(Move(square, pop_square(targets)));
     }
+}
 
-    // Check for promotion condition if the pawn is one move away from promotion
-    if ((player == white && row == 6) || (player == black && row == 1)){
-        possible_actions.promotion = true;
+template<PlayerColor Us>
+void Piece::rook_bishop_queen_rating_template_active_player(
+    Board& board_class,
+    Bitboard attacks
+) const {
+    // Handles opponent's turn: every reachable square counts, including the first blocker
+    while (attacks) {
+        update_move_rating_helping<Us>(board_class, pop_square(attacks));
     }
+}
 
-    // For the opponent's turn, focus on attack and checking logic
-    directions = {{direction_by_colour, 1}, {direction_by_colour, -1}};
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // If the target square is valid and contains an opponent piece
-        if (is_valid_position(board_class, new_row, new_column) &&
-            board_class.board[new_row][new_column] &&
-            board_class.board[new_row][new_column]->player != player
-        ) {
-            // Mark the square as a possible move
-            possible_actions.attacks.insert({new_row, new_column});
-
-            // If the piece is the opponent's king, mark it as a checking piece
-            if (board_class.board[new_row][new_column]->piece == king) {
-                board_class.checkin_pieces[{row, column}];
-            }
-        }
-        
-        // Mark the square as attacked, regardless of the target
-        if (is_valid_position(board_class, new_row, new_column)) {
-            board_class.attacked_positions.insert({new_row, new_column});
-        }
+template<PlayerColor Us>
+void Piece::rook_bishop_queen_rating_template_opponent(
+    Board& board_class,
+    int square,
+    Bitboard attacks
+) const {
+    // Handles current player's turn: only squares allowed by pins and checks count
+    attacks &= legal_targets(board_class, square);
+    while (attacks) {
+        update_move_rating_helping<Us>(board_class, pop_square(attacks));
     }
 }
 
-void Pawn::check_piece_possible_moves_active_player (
+template<PlayerColor Us, GenerationType Type>
+void Piece::pawn_possible_moves_active_player (
     Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Determine movement direction based on the pawn's color
-    int direction_by_colour = player == white ? 1: -1;
+    int square
+) const {
+    constexpr PlayerColor opponent = opponent_of(Us);
 
-    // Initialize possible forward directions for pawn movement
-    std::vector<std::array<int, 2>> directions = {{direction_by_colour, 0}};
+    // Movement direction, starting row and the row before promotion of the pawn's color
+    constexpr int forward = (Us == white) ? 8 : -8;
+    constexpr int starting_row = (Us == white) ? 1 : 6;
+    constexpr int promotion_row = (Us == white) ? 6 : 1;
 
-    // Add double move direction if the pawn is in its starting position
-    if ((player == white && row == 1) || (player == black && row == 6)) {
-        directions.push_back({direction_by_colour * 2, 0});
-    }
+    int row = position(square)[0];
+
+    // Squares allowed by pins and checks
+    Bitboard allowed = legal_targets(board_class, square);
 
     // Check for promotion condition if the pawn is one move away from promotion
-    if ((player == white && row == 6) || (player == black && row == 1)){
-        possible_actions.promotion = true;
-    }
+    bool promotion = row == promotion_row;
 
-    // For the current player's turn, focus on valid moves and attacks
-    bool can_move_second_time = true; // Indicates if the pawn can move two squares forward
-
-    // Check forward movement directions
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // If the square is valid, unoccupied, and eligible for movement
-        if (is_valid_position(board_class, new_row, new_column) &&
-            !board_class.board[new_row][new_column] &&
-            can_move_second_time
-        ) {
-            // Check if the move is not blocked by a pin or other restrictions
-            if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-            ) {
-                possible_actions.moves.insert({new_row, new_column});
-                board_class.active_pieces.insert({row, column});
+    // Add the move, or one move per promotion piece (the queen among captures, the others among quiet moves)
+    auto add_move = [&](int target, bool capture) {
+        if (promotion) {
+            if constexpr (Type != quiets) {
+                board_class.legal_moves.push_back(Move(square, target, promotion_move, queen));
             }
-        } else {
-            // If the move is blocked, the pawn can no longer move two squares forward
-            can_move_second_time = false;
-        }
-    }
-
-    // Check attack directions
-    directions = {{direction_by_colour, 1}, {direction_by_colour, -1}};
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // If the target square is valid and contains an opponent piece
-        if (is_valid_position(board_class, new_row, new_column) &&
-            board_class.board[new_row][new_column] &&
-            board_class.board[new_row][new_column]->player != player
-        ) {
-            // Ensure the move is legal and part of any check resolution
-            if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-            ) {
-                possible_actions.attacks.insert({new_row, new_column});
-                board_class.active_pieces.insert({row, column});
+            if constexpr (Type != captures) {
+                for (PieceType promoted : {knight, bishop, rook}) {
+                    board_class.legal_moves.push_back(Move(square, target, promotion_move, promoted));
+                }
             }
+        } else if ((Type == all_moves) ||
+                   (Type == captures && capture) ||
+                   (Type == quiets && !capture)) {
+            board_class.legal_moves.push_back(Move(square, target));
         }
+    };
 
-        // Handle en passant capture
-        if (is_valid_position(board_class, new_row, new_column) &&
-            std::array<int, 2>{new_row, new_column} == board_class.enpassant
-        ) {
-            // Ensure the move is legal and resolves any check conditions
-            if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-            ) {
-                possible_actions.attacks.insert({new_row, new_column});
-                board_class.active_pieces.insert({row, column});
-            }
-        }
-    }
-}
+    // Check forward movement: one square, then two squares from the starting position.
+    // Among captures only a promotion moves the pawn forward
+    int steps = (row == starting_row) ? 2 : 1;
+    if (Type == captures && !promotion) steps = 0;
+    for (int step = 1, target = square + forward; step <= steps; step++, target += forward) {
+        if (target < 0 || target >= 64) break;
 
-void Pawn::update_rating_opponent (
-    Board& board_class
-) {
-    // Determine movement direction based on the pawn's color
-    int direction_by_colour = player == white ? 1: -1;
-
-    // Initialize possible forward directions for pawn movement
-    std::vector<std::array<int, 2>> directions = {{direction_by_colour, 0}};
-
-    // For the opponent's turn, focus on attack and checking logic
-    directions = {{direction_by_colour, 1}, {direction_by_colour, -1}};
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-        
-        // Mark the square as attacked, regardless of the target
-        if (is_valid_position(board_class, new_row, new_column)) {
-            update_move_rating_helping(board_class, player, new_row, new_column);
+        // If the move is blocked, the pawn can no longer move two squares forward
+        if (board_class.occupied & square_bb(target)) break;
+
+        // Check if the move is not blocked by a pin or other restrictions
+        if (allowed & square_bb(target)) {
+            add_move(target, false);
         }
     }
-}
-
-void Pawn::update_rating_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Determine movement direction based on the pawn's color
-    int direction_by_colour = player == white ? 1: -1;
-
-    // Initialize possible forward directions for pawn movement
-    std::vector<std::array<int, 2>> directions = {{direction_by_colour, 0}};
 
     // Check attack directions
-    directions = {{direction_by_colour, 1}, {direction_by_colour, -1}};
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        if (is_valid_position(board_class, new_row, new_column) &&
-            is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces)
-        ) {
-            if (!board_class.checkin_pieces.empty() && checking_positions.count({new_row, new_column})){
-                if ((board_class.board[new_row][new_column] && board_class.board[new_row][new_column]->player != player)) {
-                    update_move_rating_helping(board_class, player, new_row, new_column);
-                } else if (std::array<int, 2>{new_row, new_column} == board_class.enpassant) {
-                    update_move_rating_helping(board_class, player, new_row - direction_by_colour, new_column);
-                }
+    Bitboard attacks = PAWN_ATTACKS[Us][square];
+    while (attacks) {
+        int target = pop_square(attacks);
 
-            } else if (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column})) {
-                if (std::array<int, 2>{new_row, new_column} == board_class.enpassant) {
-                    update_move_rating_helping(board_class, player, new_row - direction_by_colour, new_column);
-                } else {
-                    update_move_rating_helping(board_class, player, new_row, new_column);
-                }
-            }
+        // If the target square contains an opponent piece, ensure the move is legal and part of any check resolution
+        if (board_class.occupancy[opponent] & square_bb(target) & allowed) {
+            add_move(target, true);
         }
-    }
-}
 
-void Knight::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Define all possible moves for a knight relative to its current position
-    std::vector<std::array<int, 2>> directions = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
-
-    // If it is the opponent's turn, focus on marking attacked positions and checking pieces
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            board_class.attacked_positions.insert({new_row, new_column});
-
-            // If the target square contains the opponent's king, mark the knight as a checking piece
-            if (board_class.board[new_row][new_column] &&
-                board_class.board[new_row][new_column]->piece == king &&
-                board_class.board[new_row][new_column]->player != player
+        // Handle en passant capture, which may also resolve a check by removing the checking pawn
+        if (Type != quiets && position(target) == board_class.enpassant) {
+            Bitboard captured = square_bb(target - forward);
+
+            if ((board_class.pin_mask(square) & square_bb(target)) &&
+                (board_class.check_mask & (square_bb(target) | captured)) &&
+                is_enpassant_safe<Us>(board_class, square, target)
             ) {
-                board_class.checkin_pieces[{row, column}];
+                board_class.legal_moves.push_back(Move(square, target, enpassant_move));
             }
         }
     }
 }
 
-void Knight::check_piece_possible_moves_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible moves for a knight relative to its current position
-    std::vector<std::array<int, 2>> directions = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
-
-    // If it is the current player's turn, calculate valid moves and attacks
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            // If the target square is empty, it's a valid move
-            if (!board_class.board[new_row][new_column]) {
-                if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                    (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-                ) {
-                    possible_actions.moves.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-            // If the target square contains an opponent piece, it's a valid attack
-            } else if (board_class.board[new_row][new_column]->player != player) {
-                if (is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-                    (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-                ) {
-                    possible_actions.attacks.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-            }
-        }
-    }
-}
+template<PlayerColor Us>
+bool Piece::is_enpassant_safe(
+    const Board& board_class,
+    int square,
+    int target
+) const {
+    constexpr PlayerColor opponent = opponent_of(Us);
+    Bitboard king_bb = board_class.get_pieces(king, Us);
+    if (!king_bb) return true;
 
-void Knight::update_rating_opponent (
-    Board& board_class
-) {
-    // Define all possible moves for a knight relative to its current position
-    std::vector<std::array<int, 2>> directions = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
+    // Both pawns leave the row at once, which the pin detection cannot see
+    int captured = ::square(position(square)[0], position(target)[1]);
+    Bitboard occupied_after = (board_class.occupied ^ square_bb(square) ^ square_bb(captured)) | square_bb(target);
+    int king_square = lowest_square(king_bb);
 
-    // If it is the opponent's turn, focus on marking attacked positions and checking pieces
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
+    Bitboard rooks_queens = board_class.get_pieces(rook, opponent) | board_class.get_pieces(queen, opponent);
+    Bitboard bishops_queens = board_class.get_pieces(bishop, opponent) | board_class.get_pieces(queen, opponent);
 
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            update_move_rating_helping(board_class, player, new_row, new_column);
-        }
-    }
+    return !(rook_attacks(king_square, occupied_after) & rooks_queens) &&
+           !(bishop_attacks(king_square, occupied_after) & bishops_queens);
 }
 
-void Knight::update_rating_active_player (
+template<PlayerColor Us>
+void Piece::pawn_rating_active_player (
     Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible moves for a knight relative to its current position
-    std::vector<std::array<int, 2>> directions = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
-
-    // If it is the current player's turn, calculate valid moves and attacks
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column) &&
-            is_not_pinned({row, column}, {new_row, new_column}, board_class, board_class.pinned_pieces) &&
-            (board_class.checkin_pieces.empty() || checking_positions.count({new_row, new_column}))
-        ) {
-            update_move_rating_helping(board_class, player, new_row, new_column);
-        }
-    }
-}
+    int square
+) const {
+    constexpr PlayerColor opponent = opponent_of(Us);
 
-void King::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Define all possible moves for the king, including castling directions
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}, {0, -2}, {0, 2}};
-
-    // If it is the opponent's turn, focus on marking attacked positions
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            // Skip castling directions as they are not valid attacks
-            if (direction == std::array<int, 2> {0, -2} || direction == std::array<int, 2> {0, 2}) {
-                continue;
-            }
-            // Mark the square as attacked
-            board_class.attacked_positions.insert({new_row, new_column});
-        }
-    }
-}
+    // Determine movement direction based on the pawn's color
+    constexpr int forward = (Us == white) ? 8 : -8;
 
-void King::check_piece_possible_moves_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible moves for the king, including castling directions
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}, {0, -2}, {0, 2}};
-
-        // If it is the current player's turn, calculate valid moves and attacks
-        for (auto direction : directions) {
-            int new_row = row + direction[0];
-            int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            if (direction == std::array<int, 2> {0, -2}) {
-                // Check for castling to the queenside
-                if (((player == white && board_class.castling[0] == 'K') ||
-                        (player == black && board_class.castling[2] == 'k')) &&
-                    checking_positions.empty() &&
-                    !board_class.board[row][1] &&
-                    !board_class.board[row][2] &&
-                    !board_class.attacked_positions.count({row, 1}) &&
-                    !board_class.attacked_positions.count({row, 2})
-                ) {
-                    // Add queenside castling to possible moves
-                    possible_actions.moves.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-            } else if (direction == std::array<int, 2> {0, 2}) {
-                    // Check for castling to the kingside
-                    if (((player == white && board_class.castling[1] == 'Q') ||
-                            (player == black && board_class.castling[3] == 'q')) &&
-                        checking_positions.empty() &&
-                        !board_class.board[row][4] &&
-                        !board_class.board[row][5] &&
-                        !board_class.board[row][6] &&
-                        !board_class.attacked_positions.count({row, 4}) &&
-                        !board_class.attacked_positions.count({row, 5})
-                    ) {
-                        // Add kingside castling to possible moves
-                        possible_actions.moves.insert({new_row, new_column});
-                        board_class.active_pieces.insert({row, column});
-                    }
-            } else if (!board_class.board[new_row][new_column]) {
-                // If the target square is empty, it is a valid move
-                if (!board_class.attacked_positions.count({new_row, new_column})) {
-                    possible_actions.moves.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
-                }
-            } else if (board_class.board[new_row][new_column]->player != player) {
-                // If the target square contains an opponent piece, it is a valid attack
-                if (!board_class.attacked_positions.count({new_row, new_column})) {
-                    possible_actions.attacks.insert({new_row, new_column});
-                    board_class.active_pieces.insert({row, column});
+    // Check attack directions
+    Bitboard attacks = PAWN_ATTACKS[Us][square];
+    while (attacks) {
+        int target = pop_square(attacks);
+        bool enpassant = position(target) == board_class.enpassant;
+
+        if (board_class.pin_mask(square) & square_bb(target)) {
+            if (board_class.checkers && (board_class.check_mask & square_bb(target))) {
+                if (board_class.occupancy[opponent] & square_bb(target)) {
+                    update_move_rating_helping<Us>(board_class, target);
+                } else if (enpassant) {
+                    update_move_rating_helping<Us>(board_class, target - forward);
                 }
-            }
-        }
-    }
-}
 
-void King::update_rating_opponent (
-    Board& board_class
-) {
-    // Define all possible moves for the king, including castling directions
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}, {0, -2}, {0, 2}};
-
-    // If it is the opponent's turn, focus on marking attacked positions
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column)) {
-            // Skip castling directions as they are not valid attacks
-            if (direction == std::array<int, 2> {0, -2} || direction == std::array<int, 2> {0, 2}) {
-                continue;
+            } else if (!board_class.checkers) {
+                update_move_rating_helping<Us>(board_class, enpassant ? target - forward : target);
             }
-            update_move_rating_helping(board_class, player, new_row, new_column);
         }
     }
 }
 
-void King::update_rating_active_player (
+template<PlayerColor Us, GenerationType Type>
+void Piece::king_possible_moves_active_player (
     Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible moves for the king, including castling directions
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}, {0, -2}, {0, 2}};
-
-    // If it is the current player's turn, calculate valid moves and attacks
-    for (auto direction : directions) {
-        int new_row = row + direction[0];
-        int new_column = column + direction[1];
-
-        // Check if the target square is valid
-        if (is_valid_position(board_class, new_row, new_column) &&
-            direction != std::array<int, 2> {0, -2} &&
-            direction != std::array<int, 2> {0, 2} &&
-            !board_class.attacked_positions.count({new_row, new_column})
-        ) {
-            update_move_rating_helping(board_class, player, new_row, new_column);
-        }
+    int square
+) const {
+    constexpr CastlingRight kingside = (Us == white) ? white_kingside : black_kingside;
+    constexpr CastlingRight queenside = (Us == white) ? white_queenside : black_queenside;
+
+    auto [row, column] = position(square);
+    Bitboard own_rooks = board_class.get_pieces(rook, Us);
+
+    // Calculate valid moves and attacks to squares not attacked by the opponent
+    Bitboard targets = KING_ATTACKS[square] & ~board_class.occupancy[Us] & ~board_class.attacked;
+    if constexpr (Type == captures) {
+        targets &= board_class.occupancy[opponent_of(Us)];
+    } else if constexpr (Type == quiets) {
+        targets &= ~board_class.occupancy[opponent_of(Us)];
+    }
+    while (targets) {
+        board_class.legal_moves.push_back(Move(square, pop_square(targets)));
     }
-}
-
-void Rook::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_active_player(board_class, directions);
-}
-
-void Rook::check_piece_possible_moves_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_opponent(board_class, directions, checking_positions);
-}
-
-void Rook::update_rating_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_active_player(board_class, directions);
-}
-
-void Rook::update_rating_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_opponent(board_class, directions, checking_positions);
-}
-
-void Bishop::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_active_player(board_class, directions);
-}
-
-void Bishop::check_piece_possible_moves_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_opponent(board_class, directions, checking_positions);
-}
-
-void Bishop::update_rating_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_active_player(board_class, directions);
-}
-
-void Bishop::update_rating_active_player(
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
 
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_opponent(board_class, directions, checking_positions);
-}
+    // Castling is only possible from the starting square and while not in check
+    if (Type == captures || column != 3 || board_class.checkers) return;
 
-void Queen::check_piece_possible_moves_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    // Check for castling to the kingside
+    if ((board_class.castling & kingside) &&
+        (own_rooks & square_bb(::square(row, 0))) &&
+        !((board_class.occupied | board_class.attacked) & (square_bb(::square(row, 1)) | square_bb(::square(row, 2))))
+    ) {
+        board_class.legal_moves.push_back(Move(square, square - 2, castling_move));
+    }
 
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_active_player(board_class, directions);
+    // Check for castling to the queenside
+    if ((board_class.castling & queenside) &&
+        (own_rooks & square_bb(::square(row, 7))) &&
+        !(board_class.occupied & (square_bb(::square(row, 4)) | square_bb(::square(row, 5)) | square_bb(::square(row, 6)))) &&
+        !(board_class.attacked & (square_bb(::square(row, 4)) | square_bb(::square(row, 5))))
+    ) {
+        board_class.legal_moves.push_back(Move(square, square + 2, castling_move));
+    }
 }
 
-void Queen::check_piece_possible_moves_active_player (
+template<PlayerColor Us>
+void Piece::king_rating_active_player (
     Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_move_template_opponent(board_class, directions, checking_positions);
-}
-
-void Queen::update_rating_opponent (
-    Board& board_class
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_active_player(board_class, directions);
+    int square
+) const {
+    // Only squares not attacked by the opponent count for the king
+    Bitboard attacks = KING_ATTACKS[square] & ~board_class.attacked;
+    while (attacks) {
+        update_move_rating_helping<Us>(board_class, pop_square(attacks));
+    }
 }
 
-void Queen::update_rating_active_player (
-    Board& board_class,
-    const PositionSet& checking_positions
-) {
-    // Define all possible directions the rook can move (vertical and horizontal)
-    std::vector<std::array<int, 2>> directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-
-    // Utilize the shared logic for rook, bishop, and queen movement
-    rook_bishop_queen_rating_template_opponent(board_class, directions, checking_positions);
-}
+template<PlayerColor Us>
+void Piece::update_move_rating_helping(Board& board_class, int square) const {
+    // Ratings of white count up, ratings of black count down
+    constexpr int sign = (Us == white) ? 1 : -1;
+    int& attack_rating = (Us == white) ? board_class.white_attack_rating : board_class.black_attack_rating;
 
-bool Piece::check_if_legal_action(int check_row, int check_col) {
-    std::array<int, 2> current = {check_row, check_col};
-    // Check if the position is in valid moves or attacks
-    if (possible_actions.moves.find(current) != possible_actions.moves.end()) return true;
-    if (possible_actions.attacks.find(current) != possible_actions.attacks.end()) return true;
-    return false;
-}
+    Piece target = board_class.board[square];
 
-void Piece::update_move_rating_helping(Board& board_class, const PlayerColor& player, int row, int col) {
-    if (board_class.board[row][col]) {
-        if (board_class.board[row][col]->player == player) {
-            if (player == white) {
-                // Increase protecting rating only if not protecting the king
-                if (board_class.board[row][col]->piece != king) {
-                    board_class.white_attack_rating += board_class.protecting_rating_weight * board_class.board[row][col]->get_value();
-                }
-            } else {
-                // Increase attack rating against opponent's pieces
-                if (board_class.board[row][col]->piece != king) {
-                    board_class.black_attack_rating -= board_class.protecting_rating_weight * board_class.board[row][col]->get_value();
-                }
+    if (target) {
+        if (target.player() == Us) {
+            // Increase protecting rating only if not protecting the king
+            if (target.piece() != king) {
+                attack_rating += sign * board_class.protecting_rating_weight * target.get_value();
             }
         } else {
-            if (player == white) {
-                board_class.white_attack_rating += board_class.attack_rating_weight * board_class.board[row][col]->get_value();
-            } else {
-                board_class.black_attack_rating -= board_class.attack_rating_weight * board_class.board[row][col]->get_value();
-            }
+            // Increase attack rating against opponent's pieces
+            attack_rating += sign * board_class.attack_rating_weight * target.get_value();
         }
     } else {
         // Increment rating for controlling empty squares
-        if (player == white) {
-            board_class.white_attack_rating += 1;
-        } else {
-            board_class.black_attack_rating -= 1;
-        }
+        attack_rating += sign;
     }
-}
\ No newline at end of file
+}
+
+// Board picks the side to move once per node, only these instantiations are needed
+template void Piece::check_piece_possible_moves_active_player<white, all_moves>(Board&, int) const;
+template void Piece::check_piece_possible_moves_active_player<black, all_moves>(Board&, int) const;
+template void Piece::check_piece_possible_moves_active_player<white, captures>(Board&, int) const;
+template void Piece::check_piece_possible_moves_active_player<black, captures>(Board&, int) const;
+template void Piece::check_piece_possible_moves_active_player<white, quiets>(Board&, int) const;
+template void Piece::check_piece_possible_moves_active_player<black, quiets>(Board&, int) const;
+template void Piece::update_rating_opponent<white>(Board&, int) const;
+template void Piece::update_rating_opponent<black>(Board&, int) const;
+template void Piece::update_rating_active_player<white>(Board&, int) const;
+template void Piece::update_rating_active_player<black>(Board&, int) const;
@@ -0,0 +1,47 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int count) {
+    for (int i = 0; i < count; i++) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    exiting = true;
+    generation++;
+    generation.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::start(std::function<void(int)> new_job) {
+    // The job is published by the increment of the generation the workers wait on
+    job = std::move(new_job);
+    running = size();
+    generation++;
+    generation.notify_all();
+}
+
+void ThreadPool::wait() {
+    for (int current = running; current != 0; current = running) {
+        running.wait(current);
+    }
+}
+
+void ThreadPool::worker_loop(int index) {
+    std::uint64_t done = 0;
+
+    while (true) {
+        generation.wait(done);
+        if (exiting) return;
+        done = generation;
+
+        job(index);
+
+        if (--running == 0) {
+            running.notify_all();
+        }
+    }
+}
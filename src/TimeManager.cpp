@@ -0,0 +1,30 @@
+#include <algorithm>
+
+#include "TimeManager.h"
+
+void TimeManager::start(const SearchLimits& limits) {
+    start_time = std::chrono::steady_clock::now();
+    time_limited = limits.move_time > 0 || limits.time > 0;
+
+    if (limits.move_time > 0) {
+        // The whole move time may be used, less what is needed to send the move
+        hard = std::max<std::int64_t>(1, limits.move_time - MOVE_OVERHEAD);
+        soft = hard;
+    } else if (limits.time > 0) {
+        // Equal share of the remaining moves plus most of the increment, which comes back after the move
+        int moves = limits.moves_to_go > 0 ? limits.moves_to_go : DEFAULT_MOVES_TO_GO;
+        std::int64_t available = std::max<std::int64_t>(1, limits.time - MOVE_OVERHEAD);
+        std::int64_t share = limits.time / moves + limits.increment * 3 / 4;
+
+        // An iteration may overrun its share, but never the clock
+        hard = std::clamp<std::int64_t>(share * 4, 1, available);
+        soft = std::clamp<std::int64_t>(share, 1, hard);
+    } else {
+        soft = 0;
+        hard = 0;
+    }
+}
+
+std::int64_t TimeManager::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+}
@@ -0,0 +1,105 @@
+#include <bit>
+
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+
+    // Atomics cannot be copied, the buckets are created empty in a new vector
+    buckets = std::vector<Bucket>(count);
+    age = 0;
+}
+
+void TranspositionTable::clear() {
+    for (Bucket& current_bucket : buckets) {
+        for (Slot& slot : current_bucket.slots) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    age = 0;
+}
+
+void TranspositionTable::new_search() {
+    // The age has 6 bits in an entry
+    age = (age + 1) & 0x3F;
+}
+
+std::optional<TTEntry> TranspositionTable::probe(std::uint64_t key) const {
+    for (const Slot& slot : bucket(key).slots) {
+        TTEntry entry = load(slot);
+        if (entry.key == key && entry.bound() != no_bound) {
+            return entry;
+        }
+    }
+    return std::nullopt;
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, Bound bound, int score, Move best_move) {
+    Bucket& current_bucket = bucket(key);
+    Slot* replaced = &current_bucket.slots[0];
+    TTEntry replaced_entry = load(*replaced);
+
+    for (Slot& slot : current_bucket.slots) {
+        TTEntry entry = load(slot);
+
+        // Overwrite an earlier result of the same position or an empty slot
+        if (entry.key == key || entry.bound() == no_bound) {
+            replaced = &slot;
+            replaced_entry = entry;
+            break;
+        }
+
+        // Otherwise replace the entry with the least depth, counting each search of age as two plies
+        auto worth = [this](const TTEntry& candidate) {
+            return candidate.depth - 2 * ((age - candidate.age()) & 0x3F);
+        };
+        if (worth(entry) < worth(replaced_entry)) {
+            replaced = &slot;
+            replaced_entry = entry;
+        }
+    }
+
+    // Keep the deeper result of the same position from the current search unless the new one is exact
+    if (replaced_entry.key == key && replaced_entry.age() == age && replaced_entry.depth > depth && bound != exact_bound) {
+        return;
+    }
+
+    TTEntry entry;
+    entry.key = key;
+    entry.score = score;
+    entry.best_move = best_move;
+    entry.depth = std::int8_t(depth);
+    entry.age_bound = std::uint8_t((age << 2) | bound);
+
+    std::uint64_t data = pack(entry);
+    replaced->key.store(key ^ data, std::memory_order_relaxed);
+    replaced->data.store(data, std::memory_order_relaxed);
+}
+
+TTEntry TranspositionTable::load(const Slot& slot) {
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    std::uint64_t key = slot.key.load(std::memory_order_relaxed) ^ data;
+
+    TTEntry entry;
+    entry.key = key;
+    entry.score = std::int32_t(std::uint32_t(data));
+    entry.best_move = std::bit_cast<Move>(std::uint16_t(data >> 32));
+    entry.depth = std::int8_t(std::uint8_t(data >> 48));
+    entry.age_bound = std::uint8_t(data >> 56);
+    return entry;
+}
+
+std::uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    return std::uint64_t(std::uint32_t(entry.score)) |
+           (std::uint64_t(std::bit_cast<std::uint16_t>(entry.best_move)) << 32) |
+           (std::uint64_t(std::uint8_t(entry.depth)) << 48) |
+           (std::uint64_t(entry.age_bound) << 56);
+}
@@ -79,7 +79,7 @@ std::ostream& operator<<(std::ostream& out, const Actions& res) {
 
 Actions::Iterator::Iterator(
     const Actions& c,
-    const PositionSet::iterator& it,
+    const PositionSet::const_iterator& it,
     const bool& attacks_flag)
     : container(c),
       current(it),
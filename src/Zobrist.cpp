@@ -0,0 +1,46 @@
+#include "Zobrist.h"
+
+namespace {
+    // SplitMix64, a fixed seed keeps the keys identical between runs
+    constexpr std::uint64_t next_key(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    struct Keys {
+        std::array<std::array<std::uint64_t, 64>, 12> pieces{};
+        std::uint64_t black_to_move = 0;
+        std::array<std::uint64_t, 4> castling{};
+        std::array<std::uint64_t, 8> enpassant{};
+    };
+
+    constexpr Keys generate_keys() {
+        Keys keys;
+        std::uint64_t state = 20240601;
+
+        for (auto& piece_keys : keys.pieces) {
+            for (auto& key : piece_keys) {
+                key = next_key(state);
+            }
+        }
+        keys.black_to_move = next_key(state);
+        for (auto& key : keys.castling) {
+            key = next_key(state);
+        }
+        for (auto& key : keys.enpassant) {
+            key = next_key(state);
+        }
+        return keys;
+    }
+
+    constexpr Keys KEYS = generate_keys();
+}
+
+namespace Zobrist {
+    const std::array<std::array<std::uint64_t, 64>, 12> PIECES = KEYS.pieces;
+    const std::uint64_t BLACK_TO_MOVE = KEYS.black_to_move;
+    const std::array<std::uint64_t, 4> CASTLING = KEYS.castling;
+    const std::array<std::uint64_t, 8> ENPASSANT = KEYS.enpassant;
+}
\ No newline at end of file
@@ -1,11 +1,53 @@
 #include "Board.h"
 #include "Piece.h"
 #include "Game.h"
+#include "Perft.h"
 
 #include "unordered_map"
 #include "tuple"
+#include "chrono"
+#include "charconv"
+#include "string_view"
+
+// Command line mode: chess perft <depth> [fen]
+int run_perft(int argc, char* argv[]) {
+    // The whole argument has to be a depth of 0 or more
+    std::string_view text = argv[2];
+    int depth = -1;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), depth);
+    if (error != std::errc() || end != text.data() + text.size() || depth < 0) {
+        std::cerr << "Usage: " << argv[0] << " perft <depth> [fen]" << std::endl;
+        return 1;
+    }
+
+    // The FEN may be passed as one quoted argument or as separate fields
+    std::string fen;
+    for (int i = 3; i < argc; i++) {
+        if (i > 3) fen += ' ';
+        fen += argv[i];
+    }
+
+    auto board = fen.empty() ? std::expected<Board, std::string>(Board()) : Board::from_fen(fen);
+    if (!board) {
+        std::cerr << board.error() << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = perft_divide(board.value(), depth, std::cout);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::endl << "Nodes: " << nodes << std::endl;
+    std::cout << "Time: " << elapsed.count() << " s" << std::endl;
+    std::cout << "NPS: " << std::uint64_t(nodes / std::max(elapsed.count(), 1e-9)) << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && std::string(argv[1]) == "perft") {
+        return run_perft(argc, argv);
+    }
 
-int main() {
     Game& game = Game::get_instance();
 
     game.menu();
@@ -0,0 +1,54 @@
+#include "Board.h"
+#include "Perft.h"
+
+#include <chrono>
+#include <iomanip>
+
+// Reference positions with known perft results (https://www.chessprogramming.org/Perft_Results)
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    int depth;
+    std::uint64_t nodes;
+};
+
+const PerftPosition POSITIONS[] = {
+    {"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+    {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+    {"Position 3 (en passant, pins)", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083},
+    {"Position 4 (promotions, castling)", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+    {"Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+    {"Position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594},
+};
+
+// Benchmark of the move generator: runs every reference position and reports nodes per second
+int main() {
+    std::uint64_t total_nodes = 0;
+    double total_seconds = 0;
+    bool all_passed = true;
+
+    for (const PerftPosition& position : POSITIONS) {
+        Board board = Board::from_fen(position.fen).value();
+
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t nodes = perft(board, position.depth);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        bool passed = nodes == position.nodes;
+        all_passed = all_passed && passed;
+        total_nodes += nodes;
+        total_seconds += elapsed.count();
+
+        std::cout << (passed ? "[ OK ] " : "[FAIL] ") << std::left << std::setw(36) << position.name
+                  << " depth " << position.depth
+                  << "  nodes " << std::setw(10) << nodes
+                  << "  expected " << std::setw(10) << position.nodes
+                  << "  " << std::fixed << std::setprecision(3) << elapsed.count() << " s"
+                  << "  " << std::uint64_t(nodes / std::max(elapsed.count(), 1e-9)) << " nps" << std::endl;
+    }
+
+    std::cout << std::endl << "Total: " << total_nodes << " nodes in " << total_seconds << " s, "
+              << std::uint64_t(total_nodes / std::max(total_seconds, 1e-9)) << " nps" << std::endl;
+
+    return all_passed ? 0 : 1;
+}
\ No newline at end of file
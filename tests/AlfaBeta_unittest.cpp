@@ -0,0 +1,265 @@
+#include <chrono>
+
+#include "AlfaBeta.h"
+#include "Board.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    TEST(IterativeDeepening, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+        AlfaBetaPruning reference_pruning(1);
+
+        Board board;
+        board.make_action(1, 4, 3, 4, ' ');
+        board.make_action(6, 3, 4, 3, ' ');
+
+        SearchResult result = alfa_beta_pruning.iterative_deepening(board, {.depth = 3}, 10);
+
+        EXPECT_EQ(result.depth, 3);
+        ASSERT_EQ(result.root_moves.size(), std::size_t(board.legal_moves.size()));
+
+        // The best move has the score of a plain search of the same depth
+        int best = result.root_moves[0].score;
+        EXPECT_EQ(best, reference_pruning(board, 3, -100000, 100000));
+
+        // Root moves within the margin have exact scores and are sorted best first
+        for (const RootMove& root_move : result.root_moves) {
+            EXPECT_GE(best, root_move.score);
+            if (best - root_move.score <= 10) {
+                Board child = board;
+                child.make_move(root_move.move);
+                EXPECT_EQ(root_move.score, reference_pruning(child, 2, -100000, 100000));
+            }
+        }
+
+        // The principal variation starts with the best move and follows legal moves
+        ASSERT_FALSE(result.principal_variation.empty());
+        EXPECT_LE(result.principal_variation.size(), std::size_t(3));
+        EXPECT_EQ(result.principal_variation[0], result.root_moves[0].move);
+    }
+
+    TEST(IterativeDeepeningMate, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        // Black mates with Qh4# (fool's mate)
+        Board board;
+        board.make_action(1, 2, 2, 2, ' ');
+        board.make_action(6, 3, 4, 3, ' ');
+        board.make_action(1, 1, 3, 1, ' ');
+
+        SearchResult result = alfa_beta_pruning.iterative_deepening(board, {.depth = 2});
+
+        EXPECT_EQ(result.root_moves[0].move.uci(), "d8h4");
+        EXPECT_EQ(result.root_moves[0].score, -100000 - 50);
+        EXPECT_EQ(result.principal_variation, std::vector<Move>{result.root_moves[0].move});
+    }
+
+    TEST(IterativeDeepeningNoMoves, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        // Stalemate: the driver reports no move and no completed iteration
+        auto board = Board::from_fen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        SearchResult result = alfa_beta_pruning.iterative_deepening(*board, {.depth = 3});
+
+        EXPECT_TRUE(result.root_moves.empty());
+        EXPECT_EQ(result.depth, 0);
+    }
+
+    TEST(IterativeDeepeningMoveTime, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        auto board = Board::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        // Only the time stops the search, the last completed iteration is returned
+        auto start = std::chrono::steady_clock::now();
+        SearchResult result = alfa_beta_pruning.iterative_deepening(*board, {.move_time = 100});
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        EXPECT_GE(result.depth, 1);
+        EXPECT_LT(result.depth, MAX_SEARCH_DEPTH);
+        EXPECT_EQ(result.root_moves.size(), std::size_t(board->legal_moves.size()));
+        EXPECT_LT(elapsed.count(), 1000);
+
+        // So many captures that not even the first iteration completes, the first legal move is returned
+        board = Board::from_fen("rnbqkbnr/pppppppp/QQQQQQQQ/8/8/qqqqqqqq/PPPPPPPP/RNBQKBNR w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        start = std::chrono::steady_clock::now();
+        result = alfa_beta_pruning.iterative_deepening(*board, {.move_time = 100});
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        EXPECT_EQ(result.depth, 0);
+        ASSERT_EQ(result.root_moves.size(), std::size_t(1));
+        EXPECT_TRUE(board->is_legal(result.root_moves[0].move));
+        EXPECT_LT(elapsed.count(), 1000);
+    }
+
+    TEST(LazySmp, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+        alfa_beta_pruning.set_threads(4);
+        EXPECT_EQ(alfa_beta_pruning.thread_count(), 4);
+
+        // The helper threads do not change the outcome of a forced line
+        Board board = Board::from_fen("2r3k1/5ppp/8/8/8/3R4/q4PPP/3R2K1 w - - 0 1").value();
+        SearchResult result = alfa_beta_pruning.iterative_deepening(board, {.depth = 5});
+
+        EXPECT_EQ(result.depth, 5);
+        EXPECT_EQ(result.root_moves.size(), std::size_t(board.legal_moves.size()));
+        EXPECT_EQ(result.root_moves[0].move.uci(), "d3d8");
+        EXPECT_GE(result.root_moves[0].score, 100000);
+
+        // The helpers run as long as the main thread and stop with it when the time is up
+        board = Board::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1").value();
+        auto start = std::chrono::steady_clock::now();
+        result = alfa_beta_pruning.iterative_deepening(board, {.move_time = 100});
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        EXPECT_GE(result.depth, 1);
+        EXPECT_LT(elapsed.count(), 1000);
+
+        alfa_beta_pruning.set_threads(0);
+        EXPECT_EQ(alfa_beta_pruning.thread_count(), 1);
+    }
+
+    TEST(YoungBrothersWait, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+        alfa_beta_pruning.set_threads(4);
+
+        // The score of a forced mate does not depend on the order the moves are searched in, the
+        // split search has to find the sequential one exactly, also when the pool is reused
+        for (const char* fen : {
+            "2r3k1/5ppp/8/8/8/3R4/q4PPP/3R2K1 w - - 0 1",
+            "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+            "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+            "rnbqkbnr/pppp1ppp/8/4p3/6P1/5P2/PPPPP2P/RNBQKBNR b KQkq - 0 2"
+        }) {
+            Board board = Board::from_fen(fen).value();
+            AlfaBetaPruning reference_pruning(1);
+            int expected = reference_pruning(board, 5, -100000, 100000);
+            EXPECT_GE(std::abs(expected), 100000);
+            for (int i = 0; i < 3; i++) {
+                EXPECT_EQ(alfa_beta_pruning(board, 5, -100000, 100000), expected) << fen;
+            }
+        }
+
+        // Deep enough for nested split points, whose tasks the other threads take
+        Board board = Board::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1").value();
+        AlfaBetaPruning split_pruning(1);
+        split_pruning.set_threads(4);
+        split_pruning(board, 6, -100000, 100000);
+        EXPECT_GT(split_pruning.stolen_tasks(), 0u);
+
+        // The count starts again with every search, too shallow to split nothing is stolen
+        split_pruning(board, AlfaBetaPruning::SPLIT_MIN_DEPTH - 1, -100000, 100000);
+        EXPECT_EQ(split_pruning.stolen_tasks(), 0u);
+
+        // The iterative deepening search splits as well once switched on, otherwise it runs Lazy SMP
+        AlfaBetaPruning lazy_pruning(1);
+        lazy_pruning.set_threads(4);
+        lazy_pruning.iterative_deepening(board, {.depth = 6});
+        EXPECT_EQ(lazy_pruning.stolen_tasks(), 0u);
+
+        AlfaBetaPruning deepening_pruning(1);
+        deepening_pruning.set_threads(4);
+        deepening_pruning.set_young_brothers_wait(true);
+        deepening_pruning.iterative_deepening(board, {.depth = 6});
+        EXPECT_GT(deepening_pruning.stolen_tasks(), 0u);
+    }
+
+    TEST(Quiescence, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        // Taking the pawn loses the queen to the recapture, which only the quiescence search sees at depth 1
+        auto board = Board::from_fen("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        SearchResult result = alfa_beta_pruning.iterative_deepening(*board, {.depth = 1});
+        EXPECT_NE(result.root_moves[0].move.uci(), "d1d5");
+
+        Board captured = *board;
+        captured.make_move(*board->find_move(0, 4, 4, 4, ' '));
+        EXPECT_LT(alfa_beta_pruning(captured, 0, -100000, 100000), 0);
+    }
+
+    TEST(NullWindowSearch, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        auto board = Board::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        // A null window around the exact score only tells on which side of it the score is
+        int score = alfa_beta_pruning(*board, 3, -100000, 100000);
+        EXPECT_GE(alfa_beta_pruning(*board, 3, score - 1, score), score);
+        EXPECT_LE(alfa_beta_pruning(*board, 3, score, score + 1), score);
+    }
+
+    TEST(AspirationWindows, Correct) {
+        // The iterations searched within aspiration windows end with the score of a full window search
+        for (const char* fen : {
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"
+        }) {
+            AlfaBetaPruning alfa_beta_pruning(1);
+            AlfaBetaPruning reference_pruning(1);
+
+            auto board = Board::from_fen(fen);
+            ASSERT_TRUE(board.has_value());
+
+            SearchResult result = alfa_beta_pruning.iterative_deepening(*board, {.depth = 4});
+            EXPECT_EQ(result.root_moves[0].score, reference_pruning(*board, 4, -100000, 100000)) << fen;
+        }
+    }
+
+    TEST(FutilityPruning, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+
+        // White is a queen behind, which makes most quiet moves futile near the leaves,
+        // but the back rank mate starting with a rook check must still be found
+        Board board = Board::from_fen("2r3k1/5ppp/8/8/8/3R4/q4PPP/3R2K1 w - - 0 1").value();
+
+        SearchResult result = alfa_beta_pruning.iterative_deepening(board, {.depth = 4});
+
+        EXPECT_EQ(result.root_moves[0].move, board.find_move(2, 4, 7, 4, ' ').value());
+        EXPECT_GE(result.root_moves[0].score, 100000);
+    }
+
+    TEST(AspirationWindowMargin, Correct) {
+        // The score drops by 15 from depth 2 to 3, so the best move ends close to the lower end
+        // of the aspiration window and the moves within the margin reach below it
+        Board board = Board::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1").value();
+
+        AlfaBetaPruning previous_pruning(1);
+        int previous = previous_pruning.iterative_deepening(board, {.depth = 2}).root_moves[0].score;
+
+        AlfaBetaPruning alfa_beta_pruning(1);
+        SearchResult result = alfa_beta_pruning.iterative_deepening(board, {.depth = 3}, 10);
+        int best = result.root_moves[0].score;
+        EXPECT_GE(previous - best, 15);
+        EXPECT_LT(previous - best, AlfaBetaPruning::ASPIRATION_WINDOW);
+
+        // Every move the caller may choose from has the score of a full window search
+        AlfaBetaPruning reference_pruning(1);
+        for (const RootMove& root_move : result.root_moves) {
+            if (best - root_move.score <= 10) {
+                Board child = board;
+                child.make_move(root_move.move);
+                EXPECT_EQ(root_move.score, reference_pruning(child, 2, -100000, 100000)) << root_move.move.uci();
+            }
+        }
+    }
+
+    TEST(LateMoveReduction, Correct) {
+        // No reduction for the first move or at depth 1, more for deeper searches and later moves
+        EXPECT_EQ(AlfaBetaPruning::late_move_reduction(10, 1), 0);
+        EXPECT_EQ(AlfaBetaPruning::late_move_reduction(1, 30), 0);
+        EXPECT_EQ(AlfaBetaPruning::late_move_reduction(3, 4), 1);
+        EXPECT_GT(AlfaBetaPruning::late_move_reduction(12, 4), AlfaBetaPruning::late_move_reduction(3, 4));
+        EXPECT_GT(AlfaBetaPruning::late_move_reduction(12, 40), AlfaBetaPruning::late_move_reduction(12, 4));
+        EXPECT_EQ(AlfaBetaPruning::late_move_reduction(MAX_SEARCH_DEPTH + 10, 200), AlfaBetaPruning::late_move_reduction(MAX_SEARCH_DEPTH, 63));
+    }
+}
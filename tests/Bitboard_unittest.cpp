@@ -0,0 +1,75 @@
+#include "Bitboard.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    // Reference slider attacks walking every ray square by square
+    Bitboard walk_rays(int sq, Bitboard occupied, const std::vector<std::array<int, 2>>& directions) {
+        Bitboard attacks = 0;
+        auto [row, col] = position(sq);
+
+        for (auto direction : directions) {
+            for (int r = row + direction[0], c = col + direction[1];
+                r >= 0 && r < 8 && c >= 0 && c < 8;
+                r += direction[0], c += direction[1]
+            ) {
+                attacks |= square_bb(square(r, c));
+                if (occupied & square_bb(square(r, c))) break;
+            }
+        }
+        return attacks;
+    }
+
+    TEST(TestMagicAttacks, MatchRayWalk) {
+        std::vector<std::array<int, 2>> rook_directions = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        std::vector<std::array<int, 2>> bishop_directions = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+        // Pseudo-random occupancies of varying density
+        std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (int i = 0; i < 2000; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            Bitboard occupied = (i % 2) ? state : state & (state >> 11);
+
+            for (int sq = 0; sq < 64; sq++) {
+                EXPECT_EQ(rook_attacks(sq, occupied), walk_rays(sq, occupied, rook_directions));
+                EXPECT_EQ(bishop_attacks(sq, occupied), walk_rays(sq, occupied, bishop_directions));
+            }
+        }
+    }
+
+    TEST(TestMagicAttacks, EmptyBoard) {
+        // Rook in the corner sees its whole row and column
+        EXPECT_EQ(rook_attacks(square(0, 0), 0), (ROW_0 | COLUMN_0) & ~square_bb(square(0, 0)));
+        EXPECT_EQ(count_squares(rook_attacks(square(3, 4), 0)), 14);
+        EXPECT_EQ(count_squares(bishop_attacks(square(3, 4), 0)), 13);
+        EXPECT_EQ(count_squares(queen_attacks(square(3, 4), 0)), 27);
+    }
+
+    TEST(TestPawnAttacks, MatchTables) {
+        for (PlayerColor player : {white, black}) {
+            Bitboard expected = 0;
+            Bitboard pawns = 0;
+            for (int sq = 8; sq < 56; sq += 3) {
+                pawns |= square_bb(sq);
+                expected |= PAWN_ATTACKS[player][sq];
+                EXPECT_EQ(pawn_attacks(square_bb(sq), player), PAWN_ATTACKS[player][sq]);
+            }
+            EXPECT_EQ(pawn_attacks(pawns, player), expected);
+        }
+    }
+
+    TEST(TestLineTables, BetweenAndLine) {
+        Bitboard between = square_bb(square(0, 1)) | square_bb(square(0, 2));
+        EXPECT_EQ(BETWEEN[square(0, 0)][square(0, 3)], between);
+        EXPECT_EQ(BETWEEN[square(0, 3)][square(0, 0)], between);
+        EXPECT_EQ(BETWEEN[square(2, 2)][square(4, 4)], square_bb(square(3, 3)));
+        EXPECT_EQ(BETWEEN[square(0, 0)][square(1, 2)], 0);
+
+        EXPECT_EQ(LINE[square(0, 0)][square(0, 3)], ROW_0);
+        EXPECT_EQ(LINE[square(3, 0)][square(5, 0)], COLUMN_0);
+        EXPECT_EQ(count_squares(LINE[square(1, 1)][square(6, 6)]), 8);
+        EXPECT_EQ(LINE[square(0, 0)][square(1, 2)], 0);
+    }
+}
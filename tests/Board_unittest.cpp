@@ -26,51 +26,52 @@ namespace {
 
     TEST(CreateBoardMethod, Correct) {
         Board board;
-        auto actual_board = board.create_board();
+        board.create_board();
+        auto& actual_board = board.board;
         
-        std::array<std::array<std::unique_ptr<Piece>, 8>, 8> expected_board;
-
-        expected_board[0][0] = std::make_unique<Rook>('R', rook, white, 0, 0);
-        expected_board[0][1] = std::make_unique<Knight>('N', knight, white, 0, 1);
-        expected_board[0][2] = std::make_unique<Bishop>('B', bishop, white, 0, 2);
-        expected_board[0][3] = std::make_unique<King>('K', king, white, 0, 3);
-        expected_board[0][4] = std::make_unique<Queen>('Q', queen, white, 0, 4);
-        expected_board[0][5] = std::make_unique<Bishop>('B', bishop, white, 0, 5);
-        expected_board[0][6] = std::make_unique<Knight>('N', knight, white, 0, 6);
-        expected_board[0][7] = std::make_unique<Rook>('R', rook, white, 0, 7);
-
-        expected_board[1][0] = std::make_unique<Pawn>('P', pawn, white, 1, 0);
-        expected_board[1][1] = std::make_unique<Pawn>('P', pawn, white, 1, 1);
-        expected_board[1][2] = std::make_unique<Pawn>('P', pawn, white, 1, 2);
-        expected_board[1][3] = std::make_unique<Pawn>('P', pawn, white, 1, 3);
-        expected_board[1][4] = std::make_unique<Pawn>('P', pawn, white, 1, 4);
-        expected_board[1][5] = std::make_unique<Pawn>('P', pawn, white, 1, 5);
-        expected_board[1][6] = std::make_unique<Pawn>('P', pawn, white, 1, 6);
-        expected_board[1][7] = std::make_unique<Pawn>('P', pawn, white, 1, 7);
-
-        expected_board[6][0] = std::make_unique<Pawn>('p', pawn, black, 6, 0);
-        expected_board[6][1] = std::make_unique<Pawn>('p', pawn, black, 6, 1);
-        expected_board[6][2] = std::make_unique<Pawn>('p', pawn, black, 6, 2);
-        expected_board[6][3] = std::make_unique<Pawn>('p', pawn, black, 6, 3);
-        expected_board[6][4] = std::make_unique<Pawn>('p', pawn, black, 6, 4);
-        expected_board[6][5] = std::make_unique<Pawn>('p', pawn, black, 6, 5);
-        expected_board[6][6] = std::make_unique<Pawn>('p', pawn, black, 6, 6);
-        expected_board[6][7] = std::make_unique<Pawn>('p', pawn, black, 6, 7);
-
-        expected_board[7][0] = std::make_unique<Rook>('r', rook, black, 7, 0);
-        expected_board[7][1] = std::make_unique<Knight>('n', knight, black, 7, 1);
-        expected_board[7][2] = std::make_unique<Bishop>('b', bishop, black, 7, 2);
-        expected_board[7][3] = std::make_unique<King>('k', king, black, 7, 3);
-        expected_board[7][4] = std::make_unique<Queen>('q', queen, black, 7, 4);
-        expected_board[7][5] = std::make_unique<Bishop>('b', bishop, black, 7, 5);
-        expected_board[7][6] = std::make_unique<Knight>('n', knight, black, 7, 6);
-        expected_board[7][7] = std::make_unique<Rook>('r', rook, black, 7, 7);
+        std::array<Piece, 64> expected_board;
+
+        expected_board[square(0, 0)] = Piece(rook, white);
+        expected_board[square(0, 1)] = Piece(knight, white);
+        expected_board[square(0, 2)] = Piece(bishop, white);
+        expected_board[square(0, 3)] = Piece(king, white);
+        expected_board[square(0, 4)] = Piece(queen, white);
+        expected_board[square(0, 5)] = Piece(bishop, white);
+        expected_board[square(0, 6)] = Piece(knight, white);
+        expected_board[square(0, 7)] = Piece(rook, white);
+
+        expected_board[square(1, 0)] = Piece(pawn, white);
+        expected_board[square(1, 1)] = Piece(pawn, white);
+        expected_board[square(1, 2)] = Piece(pawn, white);
+        expected_board[square(1, 3)] = Piece(pawn, white);
+        expected_board[square(1, 4)] = Piece(pawn, white);
+        expected_board[square(1, 5)] = Piece(pawn, white);
+        expected_board[square(1, 6)] = Piece(pawn, white);
+        expected_board[square(1, 7)] = Piece(pawn, white);
+
+        expected_board[square(6, 0)] = Piece(pawn, black);
+        expected_board[square(6, 1)] = Piece(pawn, black);
+        expected_board[square(6, 2)] = Piece(pawn, black);
+        expected_board[square(6, 3)] = Piece(pawn, black);
+        expected_board[square(6, 4)] = Piece(pawn, black);
+        expected_board[square(6, 5)] = Piece(pawn, black);
+        expected_board[square(6, 6)] = Piece(pawn, black);
+        expected_board[square(6, 7)] = Piece(pawn, black);
+
+        expected_board[square(7, 0)] = Piece(rook, black);
+        expected_board[square(7, 1)] = Piece(knight, black);
+        expected_board[square(7, 2)] = Piece(bishop, black);
+        expected_board[square(7, 3)] = Piece(king, black);
+        expected_board[square(7, 4)] = Piece(queen, black);
+        expected_board[square(7, 5)] = Piece(bishop, black);
+        expected_board[square(7, 6)] = Piece(knight, black);
+        expected_board[square(7, 7)] = Piece(rook, black);
 
         // Compare each element in the board manually
         for (int i = 0; i < 8; i++) {
             for (int j = 0; j < 8; j++) {
-                if (actual_board[i][j].get() || expected_board[i][j]) {
-                    EXPECT_EQ(*(actual_board[i][j].get()), *(expected_board[i][j].get()));
+                if (actual_board[square(i, j)] || expected_board[square(i, j)]) {
+                    EXPECT_EQ(actual_board[square(i, j)], expected_board[square(i, j)]);
                 }
             }
         }
@@ -78,7 +79,7 @@ namespace {
 
     TEST(CreateBoardMethodWithArg, Correct) {
         Board board;
-        auto actual_board = board.create_board({{
+        board.create_board({{
             {'R', ' ', 'B', 'K', 'Q', ' ', 'N', ' '},
             {'P', ' ', 'P', ' ', 'P', ' ', 'P', ' '},
             {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
@@ -88,36 +89,37 @@ namespace {
             {' ', 'p', ' ', 'p', ' ', 'p', ' ', 'p'},
             {' ', 'n', ' ', 'k', ' ', 'b', ' ', 'r'}
         }});
+        auto& actual_board = board.board;
         
-        std::array<std::array<std::unique_ptr<Piece>, 8>, 8> expected_board;
-
-        expected_board[0][0] = std::make_unique<Rook>('R', rook, white, 0, 0);
-        expected_board[0][2] = std::make_unique<Bishop>('B', bishop, white, 0, 2);
-        expected_board[0][3] = std::make_unique<King>('K', king, white, 0, 3);
-        expected_board[0][4] = std::make_unique<Queen>('Q', queen, white, 0, 4);
-        expected_board[0][6] = std::make_unique<Knight>('N', knight, white, 0, 6);
-
-        expected_board[1][0] = std::make_unique<Pawn>('P', pawn, white, 1, 0);
-        expected_board[1][2] = std::make_unique<Pawn>('P', pawn, white,  1, 2);
-        expected_board[1][4] = std::make_unique<Pawn>('P', pawn, white,  1, 4);
-        expected_board[1][6] = std::make_unique<Pawn>('P', pawn, white,  1, 6);
-
-        expected_board[4][4] = std::make_unique<Pawn>('p', pawn, black, 4, 4);
-        expected_board[6][1] = std::make_unique<Pawn>('p', pawn, black,  6, 1);
-        expected_board[6][3] = std::make_unique<Pawn>('p', pawn, black,  6, 3);
-        expected_board[6][5] = std::make_unique<Pawn>('p', pawn, black,  6, 5);
-        expected_board[6][7] = std::make_unique<Pawn>('p', pawn, black,  6, 7);
-
-        expected_board[7][1] = std::make_unique<Knight>('n', knight, black,  7, 1);
-        expected_board[7][3] = std::make_unique<King>('k', king, black,  7, 3);
-        expected_board[7][5] = std::make_unique<Bishop>('b', bishop, black,  7, 5);
-        expected_board[7][7] = std::make_unique<Rook>('r', rook, black,  7, 7);
+        std::array<Piece, 64> expected_board;
+
+        expected_board[square(0, 0)] = Piece(rook, white);
+        expected_board[square(0, 2)] = Piece(bishop, white);
+        expected_board[square(0, 3)] = Piece(king, white);
+        expected_board[square(0, 4)] = Piece(queen, white);
+        expected_board[square(0, 6)] = Piece(knight, white);
+
+        expected_board[square(1, 0)] = Piece(pawn, white);
+        expected_board[square(1, 2)] = Piece(pawn, white);
+        expected_board[square(1, 4)] = Piece(pawn, white);
+        expected_board[square(1, 6)] = Piece(pawn, white);
+
+        expected_board[square(4, 4)] = Piece(pawn, black);
+        expected_board[square(6, 1)] = Piece(pawn, black);
+        expected_board[square(6, 3)] = Piece(pawn, black);
+        expected_board[square(6, 5)] = Piece(pawn, black);
+        expected_board[square(6, 7)] = Piece(pawn, black);
+
+        expected_board[square(7, 1)] = Piece(knight, black);
+        expected_board[square(7, 3)] = Piece(king, black);
+        expected_board[square(7, 5)] = Piece(bishop, black);
+        expected_board[square(7, 7)] = Piece(rook, black);
 
         // Compare each element in the board manually
         for (int i = 0; i < 8; i++) {
             for (int j = 0; j < 8; j++) {
-                if (actual_board[i][j].get() || expected_board[i][j]) {
-                    EXPECT_EQ(*(actual_board[i][j].get()), *(expected_board[i][j].get()));
+                if (actual_board[square(i, j)] || expected_board[square(i, j)]) {
+                    EXPECT_EQ(actual_board[square(i, j)], expected_board[square(i, j)]);
                 }
             }
         }
@@ -127,7 +129,7 @@ namespace {
         Board board;
         
         Board test_board;
-        auto expected_board = test_board.create_board({{
+        test_board.create_board({{
             {'R', 'N', 'B', 'K', 'Q', 'B', 'N', 'R'},
             {'P', 'P', 'P', 'P', 'P', 'P', 'P', 'P'},
             {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
@@ -139,13 +141,13 @@ namespace {
         }});
 
         EXPECT_EQ(board.turn, white);
-        EXPECT_EQ(board.castling, "KQkq");
+        EXPECT_EQ(board.castling_string(), "KQkq");
 
         // Compare each element in the board manually
         for (int i = 0; i < 8; i++) {
             for (int j = 0; j < 8; j++) {
-                if (board.board[i][j].get() || expected_board[i][j]) {
-                    EXPECT_EQ(*(board.board[i][j].get()), *(expected_board[i][j].get()));
+                if (board.board[square(i, j)] || test_board.board[square(i, j)]) {
+                    EXPECT_EQ(board.board[square(i, j)], test_board.board[square(i, j)]);
                 }
             }
         }
@@ -164,7 +166,7 @@ namespace {
         }});
         
         Board test_board;
-        auto expected_board = test_board.create_board({{
+        test_board.create_board({{
             {'R', ' ', 'B', 'K', 'Q', ' ', 'N', ' '},
             {'P', ' ', 'P', ' ', 'P', ' ', 'P', ' '},
             {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
@@ -176,7 +178,7 @@ namespace {
         }});
 
         EXPECT_EQ(board.turn, black);
-        EXPECT_EQ(board.castling, "KQkq");
+        EXPECT_EQ(board.castling_string(), "KQkq");
 
         std::array<int, 2> enpassant = {8, 8};
         EXPECT_EQ(board.enpassant, enpassant);
@@ -184,8 +186,8 @@ namespace {
         // Compare each element in the board manually
         for (int i = 0; i < 8; i++) {
             for (int j = 0; j < 8; j++) {
-                if (board.board[i][j].get() || expected_board[i][j]) {
-                    EXPECT_EQ(*(board.board[i][j].get()), *(expected_board[i][j].get()));
+                if (board.board[square(i, j)] || test_board.board[square(i, j)]) {
+                    EXPECT_EQ(board.board[square(i, j)], test_board.board[square(i, j)]);
                 }
             }
         }
@@ -204,7 +206,7 @@ namespace {
         }});
         
         Board test_board;
-        auto expected_board = test_board.create_board({{
+        test_board.create_board({{
             {'R', ' ', 'B', 'K', 'Q', ' ', 'N', ' '},
             {'P', ' ', 'P', ' ', 'P', ' ', 'P', ' '},
             {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
@@ -216,7 +218,7 @@ namespace {
         }});
 
         EXPECT_EQ(board.turn, black);
-        EXPECT_EQ(board.castling, "KQ__");
+        EXPECT_EQ(board.castling_string(), "KQ__");
 
         std::array<int, 2> enpassant = {2, 2};
         EXPECT_EQ(board.enpassant, enpassant);
@@ -224,8 +226,8 @@ namespace {
         // Compare each element in the board manually
         for (int i = 0; i < 8; i++) {
             for (int j = 0; j < 8; j++) {
-                if (board.board[i][j].get() || expected_board[i][j]) {
-                    EXPECT_EQ(*(board.board[i][j].get()), *(expected_board[i][j].get()));
+                if (board.board[square(i, j)] || test_board.board[square(i, j)]) {
+                    EXPECT_EQ(board.board[square(i, j)], test_board.board[square(i, j)]);
                 }
             }
         }
@@ -906,7 +908,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[3][4]->possible_actions,
+            board.get_actions(3, 4),
             create_expected_possible_actions(
                 {{2, 4}},
                 {},
@@ -915,7 +917,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[0][0]->possible_actions,
+            board.get_actions(0, 0),
             create_expected_possible_actions(
                 {},
                 {},
@@ -926,7 +928,7 @@ namespace {
         board.make_action(3, 4, 2, 4, ' ');
 
         EXPECT_EQ(
-            board.board[2][4]->possible_actions,
+            board.get_actions(2, 4),
             create_expected_possible_actions(
                 {},
                 {},
@@ -935,7 +937,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[0][0]->possible_actions,
+            board.get_actions(0, 0),
             create_expected_possible_actions(
                 {{1, 0}, {1, 1}, {0, 1}},
                 {},
@@ -946,7 +948,7 @@ namespace {
         board.make_action(0, 0, 1, 0, ' ');
 
         EXPECT_EQ(
-            board.board[2][4]->possible_actions,
+            board.get_actions(2, 4),
             create_expected_possible_actions(
                 {{1, 4}},
                 {},
@@ -955,7 +957,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][0]->possible_actions,
+            board.get_actions(1, 0),
             create_expected_possible_actions(
                 {},
                 {},
@@ -966,7 +968,7 @@ namespace {
         board.make_action(2, 4, 1, 4, ' ');
 
         EXPECT_EQ(
-            board.board[1][4]->possible_actions,
+            board.get_actions(1, 4),
             create_expected_possible_actions(
                 {},
                 {},
@@ -975,7 +977,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][0]->possible_actions,
+            board.get_actions(1, 0),
             create_expected_possible_actions(
                 {{0, 0}, {0, 1}, {1, 1}, {2, 0}, {2, 1}},
                 {},
@@ -1151,6 +1153,219 @@ namespace {
         );
     }
 
+    TEST(MakeUnmakeMove, Correct) {
+        Board board(white, "KQkq", {5, 3}, {{
+            {'R', ' ', ' ', 'K', ' ', ' ', ' ', 'R'},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', 'P', 'p', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', 'P', ' ', ' ', ' ', ' ', ' ', ' '},
+            {'r', ' ', ' ', 'k', ' ', ' ', ' ', 'r'}
+        }});
+
+        Board original_board = board;
+        original_board.get_possible_actions();
+
+        // Castling on both sides, en passant and a promotion with a capture
+        std::vector<std::array<int, 4>> moves = {{0, 3, 0, 1}, {0, 3, 0, 5}, {4, 2, 5, 3}, {6, 1, 7, 0}};
+
+        for (auto move : moves) {
+            Board expected_board = board.make_action_board(move[0], move[1], move[2], move[3], 'Q');
+            UndoRecord undo = board.make_move(*board.find_move(move[0], move[1], move[2], move[3], 'Q'));
+
+            board.get_possible_actions();
+            expected_board.get_possible_actions();
+            EXPECT_EQ(board, expected_board);
+
+            board.unmake_move(undo);
+            board.get_possible_actions();
+            EXPECT_EQ(board, original_board);
+        }
+    }
+
+    TEST(ZobristHash, Correct) {
+        Board board;
+        Board transposed_board;
+
+        // Knights out and back in a different order reach the same position
+        board.make_action(0, 1, 2, 2, ' ');
+        board.make_action(7, 1, 5, 2, ' ');
+        board.make_action(0, 6, 2, 5, ' ');
+        transposed_board.make_action(0, 6, 2, 5, ' ');
+        transposed_board.make_action(7, 1, 5, 2, ' ');
+        transposed_board.make_action(0, 1, 2, 2, ' ');
+
+        EXPECT_EQ(board.hash(), transposed_board.hash());
+
+        // Double pawn push (en passant square), then castling (rights and rook move)
+        board.make_action(6, 3, 4, 3, ' ');
+        board.make_action(1, 1, 2, 1, ' ');
+        board.make_action(6, 1, 5, 1, ' ');
+        board.make_action(0, 2, 1, 1, ' ');
+        board.make_action(7, 2, 6, 1, ' ');
+        board.make_action(0, 3, 0, 1, ' ');
+
+        Board expected_board(black, "__kq", {{
+            {' ', 'K', 'R', ' ', 'Q', 'B', ' ', 'R'},
+            {'P', 'B', 'P', 'P', 'P', 'P', 'P', 'P'},
+            {' ', 'P', 'N', ' ', ' ', 'N', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', 'p', ' ', ' ', ' ', ' '},
+            {' ', 'p', 'n', ' ', ' ', ' ', ' ', ' '},
+            {'p', 'b', 'p', ' ', 'p', 'p', 'p', 'p'},
+            {'r', ' ', ' ', 'k', 'q', 'b', 'n', 'r'}
+        }});
+
+        EXPECT_EQ(board, expected_board);
+        EXPECT_EQ(board.hash(), expected_board.hash());
+        EXPECT_NE(board.hash(), transposed_board.hash());
+    }
+
+    TEST(CheckAndPinMasks, Correct) {
+        Board board(white, "____", {{
+            {' ', ' ', ' ', 'K', ' ', ' ', ' ', ' '},
+            {' ', ' ', 'N', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {'b', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', 'r', 'k', ' ', ' ', ' '}
+        }});
+
+        // The rook checks along the file, the knight is pinned by the bishop
+        EXPECT_EQ(board.checkers, square_bb(square(7, 3)));
+        EXPECT_EQ(board.check_mask, BETWEEN[square(0, 3)][square(7, 3)] | square_bb(square(7, 3)));
+        EXPECT_EQ(board.pinned, square_bb(square(1, 2)));
+        EXPECT_EQ(board.pin_mask(square(1, 2)), LINE[square(0, 3)][square(3, 0)]);
+        EXPECT_EQ(board.pin_mask(square(0, 3)), ~Bitboard(0));
+        EXPECT_TRUE(board.get_actions(1, 2).moves.empty());
+        EXPECT_TRUE(board.get_actions(1, 2).attacks.empty());
+
+        Board double_check(white, "____", {{
+            {' ', ' ', ' ', 'K', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', 'R'},
+            {' ', ' ', 'n', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', 'r', 'k', ' ', ' ', ' '}
+        }});
+
+        // Only the king can answer a double check
+        EXPECT_EQ(double_check.checkers, square_bb(square(7, 3)) | square_bb(square(2, 2)));
+        EXPECT_EQ(double_check.check_mask, 0);
+        for (const Move& move : double_check.legal_moves) {
+            EXPECT_EQ(move.from(), square(0, 3));
+        }
+    }
+
+    TEST(IsAttacked, Correct) {
+        Board board(white, "____", {{
+            {' ', ' ', ' ', 'K', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', 'p', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+            {' ', ' ', ' ', ' ', ' ', ' ', ' ', 'n'},
+            {'r', ' ', ' ', ' ', 'k', ' ', ' ', ' '}
+        }});
+
+        EXPECT_TRUE(board.is_attacked(square(2, 4), black)); // Pawn
+        EXPECT_TRUE(board.is_attacked(square(2, 6), black));
+        EXPECT_FALSE(board.is_attacked(square(2, 5), black));
+        EXPECT_TRUE(board.is_attacked(square(4, 6), black)); // Knight
+        EXPECT_TRUE(board.is_attacked(square(0, 0), black)); // Rook
+        EXPECT_FALSE(board.is_attacked(square(0, 1), black));
+        EXPECT_TRUE(board.is_attacked(square(1, 3), white)); // King
+
+        // The attack mask matches the query for every square
+        for (int sq = 0; sq < 64; sq++) {
+            EXPECT_EQ(bool(board.attacked & square_bb(sq)), board.is_attacked(sq, black));
+        }
+    }
+
+    TEST(PossibleCaptures, Correct) {
+        // Captures and the queen promotion only, castling and quiet moves are left out
+        auto board = Board::from_fen("r3k3/1P6/8/3p4/8/8/8/R2QK2R w KQq - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        board->get_possible_captures();
+        std::vector<std::string> moves;
+        for (const Move& move : board->legal_moves) {
+            moves.push_back(move.uci());
+        }
+        std::sort(moves.begin(), moves.end());
+        EXPECT_EQ(moves, (std::vector<std::string>{"a1a8", "b7a8q", "b7b8q", "d1d5"}));
+
+        // In check every evasion is generated
+        auto check = Board::from_fen("4k3/8/8/8/8/8/8/r3K3 w - - 0 1");
+        ASSERT_TRUE(check.has_value());
+
+        check->get_possible_captures();
+        EXPECT_EQ(check->legal_moves.size(), 3);
+    }
+
+    TEST(IsLegal, Correct) {
+        auto board = Board::from_fen("4k3/8/8/8/8/8/3r4/4K3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        int legal_moves = board->legal_moves.size();
+
+        EXPECT_TRUE(board->is_legal(Move(square(0, 3), square(1, 4)))); // Kxd2
+        EXPECT_FALSE(board->is_legal(Move(square(0, 3), square(1, 3)))); // Ke2 stays in check
+        EXPECT_FALSE(board->is_legal(Move(square(7, 3), square(6, 3)))); // Not the side to move
+        EXPECT_EQ(board->legal_moves.size(), legal_moves);
+    }
+
+    TEST(StaticExchangeEvaluation, Correct) {
+        // Undefended pawn
+        auto board = Board::from_fen("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board->see(Move(square(0, 3), square(4, 3))), 1); // Rxe5
+
+        // Pawn defended by a pawn
+        board = Board::from_fen("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board->see(Move(square(0, 4), square(4, 4))), -8); // Qxd5
+
+        // The rook behind the first one recaptures through it
+        board = Board::from_fen("4k3/4r3/8/4p3/8/8/4R3/4R1K1 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board->see(Move(square(1, 3), square(4, 3))), 1); // Rxe5
+
+        // Knight lost for a pawn, the queen x-rays behind the rook
+        board = Board::from_fen("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board->see(Move(square(2, 4), square(4, 3))), -2); // Nxe5
+
+        // The king cannot recapture on a defended square
+        board = Board::from_fen("8/8/8/4k3/3p4/8/3R4/3RK3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board->see(Move(square(1, 4), square(3, 4))), 1); // Rxd4
+    }
+
+    TEST(NullMove, Correct) {
+        auto board = Board::from_fen("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2");
+        auto passed = Board::from_fen("4k3/8/8/3pP3/8/8/8/4K3 b - - 0 2");
+        ASSERT_TRUE(board.has_value() && passed.has_value());
+        std::uint64_t key = board->hash();
+
+        // The turn passes and the en passant capture is gone, as in the position with the other side to move
+        UndoRecord undo = board->make_null_move();
+        EXPECT_EQ(board->turn, black);
+        EXPECT_EQ(board->enpassant, (std::array<int, 2>{8, 8}));
+        EXPECT_EQ(board->hash(), passed->hash());
+
+        board->unmake_null_move(undo);
+        EXPECT_EQ(board->turn, white);
+        EXPECT_EQ(board->enpassant, (std::array<int, 2>{5, 4}));
+        EXPECT_EQ(board->hash(), key);
+    }
+
     TEST(MinimaxWhiteMate, Correct) {
         Game& game = Game::get_instance();
 
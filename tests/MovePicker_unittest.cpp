@@ -0,0 +1,75 @@
+#include "MovePicker.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    TEST(MovePickerOrder, Correct) {
+        auto board = Board::from_fen("4k3/1P6/2p5/3p4/2r5/8/1N6/3QK3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+        int legal_moves = board->legal_moves.size();
+
+        HistoryTable history{};
+        history[white][square(0, 3)][square(1, 3)] = 5; // Ke2
+        history[white][square(0, 3)][square(0, 2)] = 3; // Kf1
+
+        Move hash_move = *board->find_move(1, 6, 3, 7, ' '); // Na4
+        Move killer = *board->find_move(0, 4, 2, 6, ' '); // Qb3
+        MovePicker picker(*board, hash_move, {killer, NO_MOVE}, history);
+
+        std::vector<std::string> moves;
+        for (Move move = picker.next(); move != NO_MOVE; move = picker.next()) {
+            moves.push_back(move.uci());
+        }
+
+        // Hash move, queen promotion, capture of the rook, the killer, the quiet moves with a
+        // history score, the rest and last the capture of the defended pawn by the queen
+        ASSERT_EQ(moves.size(), std::size_t(legal_moves));
+        EXPECT_EQ(
+            std::vector<std::string>(moves.begin(), moves.begin() + 6),
+            (std::vector<std::string>{"b2a4", "b7b8q", "b2c4", "d1b3", "e1e2", "e1f1"})
+        );
+        EXPECT_EQ(moves.back(), "d1d5");
+    }
+
+    TEST(MovePickerCaptures, Correct) {
+        auto board = Board::from_fen("4k3/8/8/3p4/2r5/8/1N6/3QK3 w - - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        // Moves generated beforehand, most valuable victim first
+        board->get_possible_captures();
+        MovePicker picker(*board);
+
+        EXPECT_EQ(picker.next().uci(), "b2c4");
+        EXPECT_EQ(picker.next().uci(), "d1d5");
+        EXPECT_EQ(picker.next(), NO_MOVE);
+    }
+
+    TEST(MovePickerStages, Correct) {
+        auto board = Board::from_fen("r3k3/1P6/8/3p4/8/8/8/R2QK2R w KQq - 0 1");
+        ASSERT_TRUE(board.has_value());
+
+        // Every legal move is picked exactly once, the quiet stage adds castling and underpromotions.
+        // The moves are searched in between, which leaves the analysis of the child on the board
+        HistoryTable history{};
+        MovePicker picker(*board, NO_MOVE, {NO_MOVE, NO_MOVE}, history);
+
+        std::vector<std::string> picked;
+        for (Move move = picker.next(); move != NO_MOVE; move = picker.next()) {
+            picked.push_back(move.uci());
+
+            UndoRecord undo = board->make_move(move);
+            board->get_possible_actions();
+            board->unmake_move(undo);
+        }
+
+        board->get_possible_actions();
+        std::vector<std::string> expected;
+        for (const Move& move : board->legal_moves) {
+            expected.push_back(move.uci());
+        }
+
+        std::sort(picked.begin(), picked.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(picked, expected);
+    }
+}
@@ -0,0 +1,78 @@
+#include "Board.h"
+#include "Perft.h"
+
+#include "gtest/gtest.h"
+#include <sstream>
+
+namespace {
+    std::uint64_t perft_from_fen(const std::string& fen, int depth) {
+        Board board = Board::from_fen(fen).value();
+        return perft(board, depth);
+    }
+
+    TEST(FenStartPosition, Correct) {
+        auto board = Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+        ASSERT_TRUE(board.has_value());
+
+        // Copies do not keep the possible actions, the assignment recalculates them
+        Board fen_board;
+        fen_board = board.value();
+
+        EXPECT_EQ(fen_board, Board());
+        EXPECT_EQ(fen_board.hash(), Board().hash());
+    }
+
+    TEST(FenEnpassantAndCastling, Correct) {
+        auto board = Board::from_fen("r3k3/8/8/3pP3/8/8/8/4K2R w Kq d6 0 1");
+
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(board.value().turn, white);
+        EXPECT_EQ(board.value().castling_string(), "K__q");
+        EXPECT_EQ(board.value().enpassant, (std::array<int, 2>{5, 4}));
+        EXPECT_EQ(board.value().get_symbol(4, 3), 'P');
+        EXPECT_EQ(board.value().get_symbol(4, 4), 'p');
+    }
+
+    TEST(FenInvalid, Correct) {
+        EXPECT_FALSE(Board::from_fen("").has_value());
+        EXPECT_FALSE(Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1").has_value());
+        EXPECT_FALSE(Board::from_fen("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1").has_value());
+        EXPECT_FALSE(Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1").has_value());
+        EXPECT_FALSE(Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KX - 0 1").has_value());
+    }
+
+    TEST(PerftStartPosition, Correct) {
+        Board board;
+
+        EXPECT_EQ(perft(board, 1), 20);
+        EXPECT_EQ(perft(board, 2), 400);
+        EXPECT_EQ(perft(board, 3), 8902);
+
+        // Below depth 1 the position itself is the only leaf
+        EXPECT_EQ(perft(board, 0), 1);
+        EXPECT_EQ(perft(board, -1), 1);
+    }
+
+    TEST(PerftKiwipete, Correct) {
+        EXPECT_EQ(perft_from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3), 97862);
+    }
+
+    TEST(PerftEnpassantPins, Correct) {
+        EXPECT_EQ(perft_from_fen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4), 43238);
+    }
+
+    TEST(PerftPromotions, Correct) {
+        EXPECT_EQ(perft_from_fen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3), 9467);
+        EXPECT_EQ(perft_from_fen("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3), 62379);
+    }
+
+    TEST(PerftDivide, Correct) {
+        Board board;
+        std::ostringstream out;
+
+        EXPECT_EQ(perft_divide(board, 2, out), 400);
+        EXPECT_NE(out.str().find("e2e4: 20"), std::string::npos);
+        EXPECT_NE(out.str().find("g1f3: 20"), std::string::npos);
+    }
+}
@@ -48,7 +48,7 @@ namespace {
 
         // WHITE
         EXPECT_EQ(
-            board_white.board[1][0]->possible_actions,
+            board_white.get_actions(1, 0),
             create_expected_possible_actions(
                 {},
                 {},
@@ -57,7 +57,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[2][4]->possible_actions,
+            board_white.get_actions(2, 4),
             create_expected_possible_actions(
                 {{3, 4}},
                 {},
@@ -66,7 +66,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[1][6]->possible_actions,
+            board_white.get_actions(1, 6),
             create_expected_possible_actions(
                 {{2, 6}, {3, 6}},
                 {},
@@ -75,7 +75,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[0][0]->possible_actions,
+            board_white.get_actions(0, 0),
             create_expected_possible_actions(
                 {{0, 1}, {0, 2}, {0, 3}},
                 {},
@@ -84,7 +84,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[5][7]->possible_actions,
+            board_white.get_actions(5, 7),
             create_expected_possible_actions(
                 {{4, 7}, {3, 7}, {2, 7}, {1, 7}, {0, 7}, {5, 6}},
                 {{6, 7}, {5, 5}},
@@ -93,7 +93,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[2][0]->possible_actions,
+            board_white.get_actions(2, 0),
             create_expected_possible_actions(
                 {{0, 1}, {3, 2}, {1, 2}},
                 {},
@@ -102,7 +102,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[6][4]->possible_actions,
+            board_white.get_actions(6, 4),
             create_expected_possible_actions(
                 {{4, 5}, {7, 6}, {5, 6}, {5, 2}},
                 {{7, 2}},
@@ -111,7 +111,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[4][1]->possible_actions,
+            board_white.get_actions(4, 1),
             create_expected_possible_actions(
                 {{5, 2}, {5, 0}, {3, 2}, {2, 3}, {1, 4}, {0, 5}, {3, 0}},
                 {{6, 3}},
@@ -120,7 +120,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[4][3]->possible_actions,
+            board_white.get_actions(4, 3),
             create_expected_possible_actions(
                 {{5, 3}, {3, 3}, {2, 3}, {1, 3}, {0, 3}, {4, 4}, {4, 5}, {4, 6}, {4, 7}, {4, 2}, {5, 2}, {6, 1}, {3, 4}, {2, 5}, {3, 2}, {2, 1}},
                 {{6, 3}, {5, 4}, {7, 0}},
@@ -129,7 +129,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_white.board[0][4]->possible_actions,
+            board_white.get_actions(0, 4),
             create_expected_possible_actions(
                 {{1, 4}, {0, 5}, {0, 3}, {1, 5}, {1, 3}},
                 {},
@@ -139,7 +139,7 @@ namespace {
 
         // BLACK
         EXPECT_EQ(
-            board_black.board[6][3]->possible_actions,
+            board_black.get_actions(6, 3),
             create_expected_possible_actions(
                 {{5, 3}},
                 {},
@@ -148,7 +148,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[5][4]->possible_actions,
+            board_black.get_actions(5, 4),
             create_expected_possible_actions(
                 {{4, 4}},
                 {{4, 3}},
@@ -157,7 +157,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[6][7]->possible_actions,
+            board_black.get_actions(6, 7),
             create_expected_possible_actions(
                 {},
                 {},
@@ -166,7 +166,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[7][0]->possible_actions,
+            board_black.get_actions(7, 0),
             create_expected_possible_actions(
                 {{6, 0}, {5, 0}, {4, 0}, {3, 0}},
                 {{2, 0}},
@@ -175,7 +175,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[7][4]->possible_actions,
+            board_black.get_actions(7, 4),
             create_expected_possible_actions(
                 {{7, 5}, {7, 6}, {7, 7}},
                 {{6, 4}},
@@ -184,7 +184,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[7][1]->possible_actions,
+            board_black.get_actions(7, 1),
             create_expected_possible_actions(
                 {{5, 2}, {5, 0}},
                 {},
@@ -193,7 +193,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[5][5]->possible_actions,
+            board_black.get_actions(5, 5),
             create_expected_possible_actions(
                 {{7, 6}, {3, 6}, {3, 4}, {4, 7}},
                 {{4 ,3}},
@@ -202,7 +202,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[7][2]->possible_actions,
+            board_black.get_actions(7, 2),
             create_expected_possible_actions(
                 {{6, 1}, {5, 0}},
                 {},
@@ -211,7 +211,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_black.board[7][3]->possible_actions,
+            board_black.get_actions(7, 3),
             create_expected_possible_actions(
                 {{6, 2}},
                 {{6, 4}},
@@ -234,7 +234,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[3][4]->possible_actions,
+            board.get_actions(3, 4),
             create_expected_possible_actions(
                 {{4, 3}},
                 {},
@@ -256,7 +256,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[3][4]->possible_actions,
+            board.get_actions(3, 4),
             create_expected_possible_actions(
                 {{4, 3}},
                 {},
@@ -278,7 +278,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[2][5]->possible_actions,
+            board.get_actions(2, 5),
             create_expected_possible_actions(
                 {},
                 {{1, 6}},
@@ -287,7 +287,7 @@ namespace {
         );
         
         EXPECT_EQ(
-            board.board[3][2]->possible_actions,
+            board.get_actions(3, 2),
             create_expected_possible_actions(
                 {},
                 {},
@@ -296,7 +296,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[5][2]->possible_actions,
+            board.get_actions(5, 2),
             create_expected_possible_actions(
                 {{6, 1}, {4, 3}},
                 {{7, 0}},
@@ -318,7 +318,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[4][0]->possible_actions,
+            board.get_actions(4, 0),
             create_expected_possible_actions(
                 {},
                 {{3, 1}},
@@ -327,7 +327,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[4][2]->possible_actions,
+            board.get_actions(4, 2),
             create_expected_possible_actions(
                 {{3, 2}},
                 {{3, 1}},
@@ -336,7 +336,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[3][7]->possible_actions,
+            board.get_actions(3, 7),
             create_expected_possible_actions(
                 {},
                 {},
@@ -345,7 +345,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[7][5]->possible_actions,
+            board.get_actions(7, 5),
             create_expected_possible_actions(
                 {{3, 5}},
                 {},
@@ -354,7 +354,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][2]->possible_actions,
+            board.get_actions(1, 2),
             create_expected_possible_actions(
                 {{3, 3}},
                 {{3, 1}},
@@ -363,7 +363,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][3]->possible_actions,
+            board.get_actions(1, 3),
             create_expected_possible_actions(
                 {{3, 5}},
                 {{3, 1}},
@@ -372,7 +372,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[7][1]->possible_actions,
+            board.get_actions(7, 1),
             create_expected_possible_actions(
                 {{3, 5}},
                 {{3, 1}},
@@ -381,7 +381,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[3][6]->possible_actions,
+            board.get_actions(3, 6),
             create_expected_possible_actions(
                 {{2, 5}, {2, 6}, {2, 7}, {4, 5}, {4, 6}, {4, 7}},
                 {},
@@ -403,7 +403,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[4][0]->possible_actions,
+            board.get_actions(4, 0),
             create_expected_possible_actions(
                 {},
                 {},
@@ -412,7 +412,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[4][2]->possible_actions,
+            board.get_actions(4, 2),
             create_expected_possible_actions(
                 {},
                 {},
@@ -421,7 +421,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[3][7]->possible_actions,
+            board.get_actions(3, 7),
             create_expected_possible_actions(
                 {},
                 {},
@@ -430,7 +430,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[7][5]->possible_actions,
+            board.get_actions(7, 5),
             create_expected_possible_actions(
                 {},
                 {},
@@ -439,7 +439,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][2]->possible_actions,
+            board.get_actions(1, 2),
             create_expected_possible_actions(
                 {},
                 {},
@@ -448,7 +448,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[1][3]->possible_actions,
+            board.get_actions(1, 3),
             create_expected_possible_actions(
                 {},
                 {},
@@ -457,7 +457,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[7][1]->possible_actions,
+            board.get_actions(7, 1),
             create_expected_possible_actions(
                 {},
                 {},
@@ -466,7 +466,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board.board[3][6]->possible_actions,
+            board.get_actions(3, 6),
             create_expected_possible_actions(
                 {{2, 5}, {2, 7}, {4, 5}, {4, 7}},
                 {},
@@ -499,7 +499,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board_q.board[7][3]->possible_actions,
+            board_q.get_actions(7, 3),
             create_expected_possible_actions(
                 {{7, 2}, {6, 2}, {6, 3}, {6, 4}, {7, 4}, {7, 5}},
                 {},
@@ -508,7 +508,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_k.board[7][3]->possible_actions,
+            board_k.get_actions(7, 3),
             create_expected_possible_actions(
                 {{7, 2}, {6, 2}, {6, 3}, {6, 4}, {7, 4}, {7, 1}},
                 {},
@@ -530,7 +530,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[7][3]->possible_actions,
+            board.get_actions(7, 3),
             create_expected_possible_actions(
                 {{7, 2}, {6, 2}, {6, 3}, {6, 4}, {7, 4}},
                 {},
@@ -552,7 +552,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[7][3]->possible_actions,
+            board.get_actions(7, 3),
             create_expected_possible_actions(
                 {{7, 2}, {6, 2}, {6, 3}, {7, 4}},
                 {},
@@ -574,7 +574,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board.board[7][3]->possible_actions,
+            board.get_actions(7, 3),
             create_expected_possible_actions(
                 {{7, 2}, {6, 2}, {6, 3}, {7, 4}},
                 {},
@@ -618,7 +618,7 @@ namespace {
         }});
 
         EXPECT_EQ(
-            board_24.board[3][3]->possible_actions,
+            board_24.get_actions(3, 3),
             create_expected_possible_actions(
                 {{2, 3}},
                 {{2, 4}},
@@ -627,7 +627,7 @@ namespace {
         );
         
         EXPECT_EQ(
-            board_NN.board[3][3]->possible_actions,
+            board_NN.get_actions(3, 3),
             create_expected_possible_actions(
                 {{2, 3}},
                 {},
@@ -636,7 +636,7 @@ namespace {
         );
 
         EXPECT_EQ(
-            board_24_check.board[3][3]->possible_actions,
+            board_24_check.get_actions(3, 3),
             create_expected_possible_actions(
                 {{2, 3}},
                 {{2, 4}},
@@ -0,0 +1,39 @@
+#include <array>
+#include <atomic>
+
+#include "ThreadPool.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    TEST(ThreadPoolJob, Correct) {
+        ThreadPool pool(3);
+        EXPECT_EQ(pool.size(), 3);
+
+        // Every worker runs the job once with its own index
+        std::array<std::atomic<int>, 3> runs{};
+        pool.start([&runs](int worker) {runs[worker]++;});
+        pool.wait();
+        for (const auto& count : runs) {
+            EXPECT_EQ(count, 1);
+        }
+
+        // The same workers take the next jobs
+        for (int i = 0; i < 10; i++) {
+            pool.start([&runs](int worker) {runs[worker] += 2;});
+            pool.wait();
+        }
+        for (const auto& count : runs) {
+            EXPECT_EQ(count, 21);
+        }
+    }
+
+    TEST(ThreadPoolEmpty, Correct) {
+        // Without workers a job finishes at once
+        ThreadPool pool(0);
+        bool ran = false;
+        pool.start([&ran](int) {ran = true;});
+        pool.wait();
+        EXPECT_FALSE(ran);
+    }
+}
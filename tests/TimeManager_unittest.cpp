@@ -0,0 +1,50 @@
+#include "TimeManager.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    TEST(TimeManagerMoveTime, Correct) {
+        TimeManager time_manager;
+
+        time_manager.start({.time = 60000, .move_time = 500});
+
+        // A fixed move time takes precedence over the clock
+        EXPECT_TRUE(time_manager.limited());
+        EXPECT_EQ(time_manager.soft_budget(), 500 - TimeManager::MOVE_OVERHEAD);
+        EXPECT_EQ(time_manager.hard_budget(), 500 - TimeManager::MOVE_OVERHEAD);
+    }
+
+    TEST(TimeManagerClock, Correct) {
+        TimeManager time_manager;
+
+        // A share of the remaining moves plus three quarters of the increment
+        time_manager.start({.time = 60000, .increment = 1000});
+        EXPECT_EQ(time_manager.soft_budget(), 60000 / TimeManager::DEFAULT_MOVES_TO_GO + 750);
+        EXPECT_EQ(time_manager.hard_budget(), 4 * time_manager.soft_budget());
+
+        time_manager.start({.time = 60000, .moves_to_go = 10});
+        EXPECT_EQ(time_manager.soft_budget(), 6000);
+        EXPECT_EQ(time_manager.hard_budget(), 24000);
+
+        // The last move before the time control never oversteps the clock
+        time_manager.start({.time = 1000, .moves_to_go = 1});
+        EXPECT_EQ(time_manager.soft_budget(), 1000 - TimeManager::MOVE_OVERHEAD);
+        EXPECT_EQ(time_manager.hard_budget(), 1000 - TimeManager::MOVE_OVERHEAD);
+
+        // Always at least one millisecond, even with an empty clock
+        time_manager.start({.time = 5});
+        EXPECT_EQ(time_manager.soft_budget(), 1);
+        EXPECT_EQ(time_manager.hard_budget(), 1);
+    }
+
+    TEST(TimeManagerDepthOnly, Correct) {
+        TimeManager time_manager;
+
+        time_manager.start({.depth = 5});
+
+        // Without a time limit the budgets never expire
+        EXPECT_FALSE(time_manager.limited());
+        EXPECT_FALSE(time_manager.soft_expired());
+        EXPECT_FALSE(time_manager.hard_expired());
+    }
+}
@@ -0,0 +1,75 @@
+#include "TranspositionTable.h"
+#include "AlfaBeta.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+    TEST(TranspositionTableSize, Correct) {
+        TranspositionTable table(1);
+
+        // 1 MB of 64-byte buckets
+        EXPECT_EQ(table.bucket_count(), 16384);
+
+        table.resize(3);
+        EXPECT_EQ(table.bucket_count(), 32768);
+    }
+
+    TEST(TranspositionTableStoreProbe, Correct) {
+        TranspositionTable table(1);
+        std::uint64_t key = 0x123456789ABCDEF0ULL;
+
+        EXPECT_FALSE(table.probe(key).has_value());
+
+        table.store(key, 3, lower_bound, 150, Move(8, 16));
+        std::optional<TTEntry> entry = table.probe(key);
+
+        ASSERT_TRUE(entry.has_value());
+        EXPECT_EQ(entry->score, 150);
+        EXPECT_EQ(entry->depth, 3);
+        EXPECT_EQ(entry->bound(), lower_bound);
+        EXPECT_EQ(entry->best_move, Move(8, 16));
+
+        table.clear();
+        EXPECT_FALSE(table.probe(key).has_value());
+    }
+
+    TEST(TranspositionTableReplacement, Correct) {
+        TranspositionTable table(1);
+        std::uint64_t buckets = table.bucket_count();
+
+        // Fill one bucket with entries of different depths
+        for (int i = 0; i < TranspositionTable::BUCKET_SIZE; i++) {
+            table.store(7 + buckets * (i + 1), 5 - i, exact_bound, i, NO_MOVE);
+        }
+
+        // A new position replaces the shallowest entry of the bucket
+        table.store(7 + buckets * 10, 4, exact_bound, 10, NO_MOVE);
+        EXPECT_FALSE(table.probe(7 + buckets * 4).has_value());
+        EXPECT_TRUE(table.probe(7 + buckets * 1).has_value());
+        EXPECT_TRUE(table.probe(7 + buckets * 10).has_value());
+
+        // Entries of older searches are replaced before deeper ones of the current search
+        for (int i = 0; i < 3; i++) {
+            table.new_search();
+        }
+        table.store(7 + buckets * 11, 1, exact_bound, 11, NO_MOVE);
+        table.store(7 + buckets * 12, 1, exact_bound, 12, NO_MOVE);
+        EXPECT_TRUE(table.probe(7 + buckets * 11).has_value());
+        EXPECT_TRUE(table.probe(7 + buckets * 12).has_value());
+        EXPECT_EQ(table.probe(7 + buckets * 1)->score, 0);
+    }
+
+    TEST(TranspositionTableSearch, Correct) {
+        AlfaBetaPruning alfa_beta_pruning(1);
+        AlfaBetaPruning reference_pruning(1);
+
+        Board board;
+        board.make_action(1, 4, 3, 4, ' ');
+        board.make_action(6, 3, 4, 3, ' ');
+
+        // The second search of a position is answered from the table with the same score
+        int first = alfa_beta_pruning(board, 3, -100000, 100000);
+        EXPECT_EQ(alfa_beta_pruning(board, 3, -100000, 100000), first);
+        EXPECT_EQ(reference_pruning(board, 3, -100000, 100000), first);
+    }
+}